@@ -36,6 +36,9 @@ EMSCRIPTEN_BINDINGS(GenOptions)
         .property("targetDistanceUnit", &mx::GenOptions::targetDistanceUnit)
         .property("addUpstreamDependencies", &mx::GenOptions::addUpstreamDependencies)
         .property("emitColorTransforms", &mx::GenOptions::emitColorTransforms)
+        .property("foldConstantNodes", &mx::GenOptions::foldConstantNodes)
+        .property("mergeDuplicateNodes", &mx::GenOptions::mergeDuplicateNodes)
+        .property("specializeUniforms", &mx::GenOptions::specializeUniforms)
         .property("hwTransparency", &mx::GenOptions::hwTransparency)
         .property("hwSpecularEnvironmentMethod", &mx::GenOptions::hwSpecularEnvironmentMethod)
         .property("hwDirectionalAlbedoMethod", &mx::GenOptions::hwDirectionalAlbedoMethod)
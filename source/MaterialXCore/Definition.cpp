@@ -34,33 +34,16 @@ const string AttributeDef::VALUE_ATTRIBUTE = "value";
 const string AttributeDef::ELEMENTS_ATTRIBUTE = "elements";
 const string AttributeDef::EXPORTABLE_ATTRIBUTE = "exportable";
 
-//
-// NodeDef methods
-//
-
-const string& NodeDef::getType() const
+namespace
 {
-    const vector<OutputPtr>& activeOutputs = getActiveOutputs();
 
-    size_t numActiveOutputs = activeOutputs.size();
-    if (numActiveOutputs > 1)
-    {
-        return MULTI_OUTPUT_TYPE_STRING;
-    }
-    else if (numActiveOutputs == 1)
-    {
-        return activeOutputs[0]->getType();
-    }
-    else
-    {
-        return DEFAULT_TYPE_STRING;
-    }
-}
-
-InterfaceElementPtr NodeDef::getImplementation(const string& target, bool resolveNodeGraph) const
+// Resolve the implementation of the given nodedef for the given target.
+InterfaceElementPtr resolveImplementation(const NodeDef& nodeDef, const string& qualifiedName,
+                                          const string& target, bool resolveNodeGraph)
 {
-    vector<InterfaceElementPtr> interfaces = getDocument()->getMatchingImplementations(getQualifiedName(getName()));
-    vector<InterfaceElementPtr> secondary = getDocument()->getMatchingImplementations(getName());
+    ConstDocumentPtr doc = nodeDef.getDocument();
+    vector<InterfaceElementPtr> interfaces = doc->getMatchingImplementations(qualifiedName);
+    vector<InterfaceElementPtr> secondary = doc->getMatchingImplementations(nodeDef.getName());
     interfaces.insert(interfaces.end(), secondary.begin(), secondary.end());
 
     // If requested, resolve Implementation elements to their linked NodeGraph elements.
@@ -71,7 +54,7 @@ InterfaceElementPtr NodeDef::getImplementation(const string& target, bool resolv
             ImplementationPtr impl = interfaces[i]->asA<Implementation>();
             if (impl && impl->hasNodeGraph())
             {
-                NodeGraphPtr nodeGraph = getDocument()->getNodeGraph(impl->getNodeGraph());
+                NodeGraphPtr nodeGraph = doc->getNodeGraph(impl->getNodeGraph());
                 if (nodeGraph)
                 {
                     interfaces[i] = nodeGraph;
@@ -88,7 +71,7 @@ InterfaceElementPtr NodeDef::getImplementation(const string& target, bool resolv
 
     // Get all candidate targets matching the given target,
     // taking inheritance into account.
-    const TargetDefPtr targetDef = getDocument()->getTargetDef(target);
+    const TargetDefPtr targetDef = doc->getTargetDef(target);
     const StringVec candidateTargets = targetDef ? targetDef->getMatchingTargets() : StringVec();
 
     // First, search for a target-specific match.
@@ -118,6 +101,50 @@ InterfaceElementPtr NodeDef::getImplementation(const string& target, bool resolv
     return InterfaceElementPtr();
 }
 
+} // anonymous namespace
+
+//
+// NodeDef methods
+//
+
+const string& NodeDef::getType() const
+{
+    const vector<OutputPtr>& activeOutputs = getActiveOutputs();
+
+    size_t numActiveOutputs = activeOutputs.size();
+    if (numActiveOutputs > 1)
+    {
+        return MULTI_OUTPUT_TYPE_STRING;
+    }
+    else if (numActiveOutputs == 1)
+    {
+        return activeOutputs[0]->getType();
+    }
+    else
+    {
+        return DEFAULT_TYPE_STRING;
+    }
+}
+
+InterfaceElementPtr NodeDef::getImplementation(const string& target, bool resolveNodeGraph) const
+{
+    // Memoize the resolved implementation for each target, since shader
+    // generation resolves the implementation of every node instance.
+    ConstDocumentPtr doc = getDocument();
+    const string qualifiedName = getQualifiedName(getName());
+    const string key = "implementation\n" + qualifiedName + "\n" + getName() + "\n" +
+                       target + "\n" + (resolveNodeGraph ? "1" : "0");
+    ElementPtr resolved;
+    if (doc->findResolvedElement(key, resolved))
+    {
+        return resolved ? resolved->asA<InterfaceElement>() : nullptr;
+    }
+
+    InterfaceElementPtr implementation = resolveImplementation(*this, qualifiedName, target, resolveNodeGraph);
+    doc->addResolvedElement(key, implementation);
+    return implementation;
+}
+
 StringMap NodeDef::getInputHints() const
 {
     StringMap hints;
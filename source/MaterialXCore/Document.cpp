@@ -5,7 +5,10 @@
 
 #include <MaterialXCore/Document.h>
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <shared_mutex>
 
 MATERIALX_NAMESPACE_BEGIN
 
@@ -25,86 +28,310 @@ DocumentPtr createDocument()
 // Document cache
 //
 
+namespace
+{
+
+// Return a new edit stamp, greater than any returned before in this process.
+size_t newEditStamp()
+{
+    static std::atomic<size_t> lastEditStamp(0);
+    return ++lastEditStamp;
+}
+
+} // anonymous namespace
+
 class Document::Cache
 {
+  public:
+    // The lookup maps of the cache, which may be shared with concurrent
+    // readers as an immutable snapshot.
+    struct Maps
+    {
+        std::unordered_map<string, std::vector<PortElementPtr>> portElementMap;
+        std::unordered_map<string, std::vector<NodeDefPtr>> nodeDefMap;
+        std::unordered_map<string, std::vector<InterfaceElementPtr>> implementationMap;
+
+        size_t size() const
+        {
+            return portElementMap.size() + nodeDefMap.size() + implementationMap.size();
+        }
+    };
+
+    static const size_t SNAPSHOT_READ_RATIO = 8;
+
   public:
     Cache() :
-        valid(false)
+        valid(false),
+        editStamp(newEditStamp()),
+        resolvedEditStamp(0),
+        snapshot(nullptr),
+        readsSinceEdit(0)
     {
     }
     ~Cache() = default;
 
-    void refresh()
+    // Call the given function with a consistent, read-only view of the cache.
+    template <class F> void read(F&& func)
     {
+        // Read from the published snapshot if present, without taking a lock.
+        const Maps* published = snapshot.load(std::memory_order_acquire);
+        if (published)
+        {
+            func(*published);
+            return;
+        }
+
         // Thread synchronization for multiple concurrent readers of a single document.
         std::lock_guard<std::mutex> guard(mutex);
 
         if (!valid)
         {
             // Clear the existing cache.
-            portElementMap.clear();
-            nodeDefMap.clear();
-            implementationMap.clear();
+            clear();
 
             // Traverse the document to build a new cache.
             for (ElementPtr elem : doc.lock()->traverseTree())
             {
-                const string& nodeName = elem->getAttribute(PortElement::NODE_NAME_ATTRIBUTE);
-                const string& nodeGraphName = elem->getAttribute(PortElement::NODE_GRAPH_ATTRIBUTE);
-                const string& nodeString = elem->getAttribute(NodeDef::NODE_ATTRIBUTE);
-                const string& nodeDefString = elem->getAttribute(InterfaceElement::NODE_DEF_ATTRIBUTE);
+                addElement(elem);
+            }
 
-                if (!nodeName.empty())
-                {
-                    PortElementPtr portElem = elem->asA<PortElement>();
-                    if (portElem)
-                    {
-                        portElementMap[portElem->getQualifiedName(nodeName)].push_back(portElem);
-                    }
-                }
-                else
-                {
-                    if (!nodeGraphName.empty())
-                    {
-                        PortElementPtr portElem = elem->asA<PortElement>();
-                        if (portElem)
-                        {
-                            portElementMap[portElem->getQualifiedName(nodeGraphName)].push_back(portElem);
-                        }
-                    }
-                }
-                if (!nodeString.empty())
+            valid = true;
+        }
+
+        // Publish a snapshot once the number of lookups since the last edit
+        // is comparable to the size of the cache, so that the cost of copying
+        // is amortized and interleaved edits and lookups remain cheap.
+        published = snapshot.load(std::memory_order_relaxed);
+        if (!published && ++readsSinceEdit * SNAPSHOT_READ_RATIO >= maps.size())
+        {
+            snapshotStorage = std::make_unique<Maps>(maps);
+            published = snapshotStorage.get();
+            snapshot.store(published, std::memory_order_release);
+        }
+
+        func(published ? *published : maps);
+    }
+
+    void invalidate()
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        editStamp = newEditStamp();
+
+        valid = false;
+        unpublish();
+    }
+
+    // Reset to an empty and valid cache.
+    void reset()
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        editStamp = newEditStamp();
+
+        clear();
+        valid = true;
+        unpublish();
+    }
+
+    void clear()
+    {
+        maps.portElementMap.clear();
+        maps.nodeDefMap.clear();
+        maps.implementationMap.clear();
+    }
+
+    // Add the given element, and optionally its descendants, to a valid cache.
+    void add(ElementPtr elem, bool recursive)
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        editStamp = newEditStamp();
+
+        if (!valid || !isInDocument(elem))
+        {
+            return;
+        }
+        unpublish();
+        if (recursive)
+        {
+            for (ElementPtr descendant : elem->traverseTree())
+            {
+                addElement(descendant);
+            }
+        }
+        else
+        {
+            addElement(elem);
+        }
+    }
+
+    // Remove the given element, and optionally its descendants, from a valid cache.
+    void remove(ElementPtr elem, bool recursive)
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        editStamp = newEditStamp();
+
+        if (!valid || !isInDocument(elem))
+        {
+            return;
+        }
+        unpublish();
+        if (recursive)
+        {
+            for (ElementPtr descendant : elem->traverseTree())
+            {
+                removeElement(descendant);
+            }
+        }
+        else
+        {
+            removeElement(elem);
+        }
+    }
+
+  private:
+    // Withdraw the published snapshot before an edit.  Since edits may not
+    // run concurrently with lookups, no reader can still be using it.
+    void unpublish()
+    {
+        readsSinceEdit = 0;
+        if (snapshotStorage)
+        {
+            snapshot.store(nullptr, std::memory_order_release);
+            snapshotStorage.reset();
+        }
+    }
+
+    // Return true if the given element is reachable from the document root,
+    // excluding elements that have been removed from their parents.
+    static bool isInDocument(ConstElementPtr elem)
+    {
+        for (ConstElementPtr parent = elem->getParent(); parent; elem = parent, parent = parent->getParent())
+        {
+            if (parent->getChild(elem->getName()) != elem)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class T> static void addEntry(std::unordered_map<string, std::vector<T>>& map, const string& key, const T& entry)
+    {
+        std::vector<T>& entries = map[key];
+        if (std::find(entries.begin(), entries.end(), entry) == entries.end())
+        {
+            entries.push_back(entry);
+        }
+    }
+
+    template <class T> static void removeEntry(std::unordered_map<string, std::vector<T>>& map, const string& key, const T& entry)
+    {
+        auto it = map.find(key);
+        if (it == map.end())
+        {
+            return;
+        }
+        std::vector<T>& entries = it->second;
+        entries.erase(std::remove(entries.begin(), entries.end(), entry), entries.end());
+        if (entries.empty())
+        {
+            map.erase(it);
+        }
+    }
+
+    template <class T> static void updateEntry(std::unordered_map<string, std::vector<T>>& map, const string& key, const T& entry, bool add)
+    {
+        if (add)
+        {
+            addEntry(map, key, entry);
+        }
+        else
+        {
+            removeEntry(map, key, entry);
+        }
+    }
+
+    // Add or remove the cache entries for a single element.
+    void updateElement(ElementPtr elem, bool add)
+    {
+        const string& nodeName = elem->getAttribute(PortElement::NODE_NAME_ATTRIBUTE);
+        const string& nodeGraphName = elem->getAttribute(PortElement::NODE_GRAPH_ATTRIBUTE);
+        const string& nodeString = elem->getAttribute(NodeDef::NODE_ATTRIBUTE);
+        const string& nodeDefString = elem->getAttribute(InterfaceElement::NODE_DEF_ATTRIBUTE);
+
+        if (!nodeName.empty())
+        {
+            PortElementPtr portElem = elem->asA<PortElement>();
+            if (portElem)
+            {
+                updateEntry(maps.portElementMap, portElem->getQualifiedName(nodeName), portElem, add);
+            }
+        }
+        else
+        {
+            if (!nodeGraphName.empty())
+            {
+                PortElementPtr portElem = elem->asA<PortElement>();
+                if (portElem)
                 {
-                    NodeDefPtr nodeDef = elem->asA<NodeDef>();
-                    if (nodeDef)
-                    {
-                        nodeDefMap[nodeDef->getQualifiedName(nodeString)].push_back(nodeDef);
-                    }
+                    updateEntry(maps.portElementMap, portElem->getQualifiedName(nodeGraphName), portElem, add);
                 }
-                if (!nodeDefString.empty())
+            }
+        }
+        if (!nodeString.empty())
+        {
+            NodeDefPtr nodeDef = elem->asA<NodeDef>();
+            if (nodeDef)
+            {
+                updateEntry(maps.nodeDefMap, nodeDef->getQualifiedName(nodeString), nodeDef, add);
+            }
+        }
+        if (!nodeDefString.empty())
+        {
+            InterfaceElementPtr interface = elem->asA<InterfaceElement>();
+            if (interface)
+            {
+                if (interface->isA<Implementation>() || interface->isA<NodeGraph>())
                 {
-                    InterfaceElementPtr interface = elem->asA<InterfaceElement>();
-                    if (interface)
-                    {
-                        if (interface->isA<Implementation>() || interface->isA<NodeGraph>())
-                        {
-                            implementationMap[interface->getQualifiedName(nodeDefString)].push_back(interface);
-                        }
-                    }
+                    updateEntry(maps.implementationMap, interface->getQualifiedName(nodeDefString), interface, add);
                 }
             }
-
-            valid = true;
         }
     }
 
+    void addElement(ElementPtr elem)
+    {
+        updateElement(elem, true);
+    }
+
+    void removeElement(ElementPtr elem)
+    {
+        updateElement(elem, false);
+    }
+
   public:
     weak_ptr<Document> doc;
     std::mutex mutex;
     bool valid;
-    std::unordered_map<string, std::vector<PortElementPtr>> portElementMap;
-    std::unordered_map<string, std::vector<NodeDefPtr>> nodeDefMap;
-    std::unordered_map<string, std::vector<InterfaceElementPtr>> implementationMap;
+    Maps maps;
+
+    // The stamp of the latest edit made to the document, used to detect
+    // stale resolved elements.  Stamps are unique across all documents.
+    std::atomic<size_t> editStamp;
+
+    // Resolved nodedefs and implementations, recorded at the given combined
+    // edit stamp of the document and its data libraries.
+    std::unordered_map<string, ElementPtr> resolvedElements;
+    size_t resolvedEditStamp;
+    std::shared_mutex resolvedMutex;
+
+  private:
+    std::atomic<const Maps*> snapshot;
+    std::unique_ptr<Maps> snapshotStorage;
+    size_t readsSinceEdit;
 };
 
 //
@@ -126,7 +353,10 @@ void Document::initialize()
     _root = getSelf();
     _cache->doc = getDocument();
 
+    // Start from an empty and valid cache, which is then maintained
+    // incrementally as elements are added, removed, and edited.
     clearContent();
+    _cache->reset();
     setVersionIntegers(MATERIALX_MAJOR_VERSION, MATERIALX_MINOR_VERSION);
 }
 
@@ -273,6 +503,15 @@ StringSet Document::getReferencedSourceUris() const
     return sourceUris;
 }
 
+void Document::setDataLibrary(ConstDocumentPtr dataLibrary)
+{
+    _dataLibrary = dataLibrary;
+    invalidateResolvedElements();
+
+    std::unique_lock<std::shared_mutex> lock(_cache->resolvedMutex);
+    _cache->resolvedElements.clear();
+}
+
 std::pair<int, int> Document::getVersionIntegers() const
 {
     if (!hasVersionString())
@@ -284,18 +523,17 @@ std::pair<int, int> Document::getVersionIntegers() const
 
 vector<PortElementPtr> Document::getMatchingPorts(const string& nodeName) const
 {
-    // Refresh the cache.
-    _cache->refresh();
-
     // Return all port elements matching the given node name.
-    if (_cache->portElementMap.count(nodeName))
+    vector<PortElementPtr> matchingPorts;
+    _cache->read([&](const Cache::Maps& maps)
     {
-        return _cache->portElementMap.at(nodeName);
-    }
-    else
-    {
-        return vector<PortElementPtr>();
-    }
+        auto it = maps.portElementMap.find(nodeName);
+        if (it != maps.portElementMap.end())
+        {
+            matchingPorts = it->second;
+        }
+    });
+    return matchingPorts;
 }
 
 ValuePtr Document::getGeomPropValue(const string& geomPropName, const string& geom) const
@@ -341,37 +579,57 @@ vector<OutputPtr> Document::getMaterialOutputs() const
 
 vector<NodeDefPtr> Document::getMatchingNodeDefs(const string& nodeName) const
 {
-    // Recurse to data library if present.
-    vector<NodeDefPtr> matchingNodeDefs = hasDataLibrary() ? 
-                                          getDataLibrary()->getMatchingNodeDefs(nodeName) :
-                                          vector<NodeDefPtr>();
-
-    // Refresh the cache.
-    _cache->refresh();
-
     // Return all nodedefs matching the given node name.
-    if (_cache->nodeDefMap.count(nodeName))
+    vector<NodeDefPtr> matchingNodeDefs;
+    _cache->read([&](const Cache::Maps& maps)
+    {
+        auto it = maps.nodeDefMap.find(nodeName);
+        if (it != maps.nodeDefMap.end())
+        {
+            matchingNodeDefs.insert(matchingNodeDefs.end(), it->second.begin(), it->second.end());
+        }
+    });
+
+    // Recurse to data library if present, skipping nodedefs that are
+    // shadowed by elements of this document.
+    if (hasDataLibrary())
     {
-        matchingNodeDefs.insert(matchingNodeDefs.end(), _cache->nodeDefMap.at(nodeName).begin(), _cache->nodeDefMap.at(nodeName).end());
+        for (NodeDefPtr nodeDef : getDataLibrary()->getMatchingNodeDefs(nodeName))
+        {
+            if (!getChild(nodeDef->getQualifiedName(nodeDef->getName())))
+            {
+                matchingNodeDefs.push_back(nodeDef);
+            }
+        }
     }
-    
+
     return matchingNodeDefs;
 }
 
 vector<InterfaceElementPtr> Document::getMatchingImplementations(const string& nodeDef) const
 {
-    // Recurse to data library if present.
-    vector<InterfaceElementPtr> matchingImplementations = hasDataLibrary() ?
-                                                          getDataLibrary()->getMatchingImplementations(nodeDef) :
-                                                          vector<InterfaceElementPtr>();
-    
-    // Refresh the cache.
-    _cache->refresh();
-
     // Return all implementations matching the given nodedef string.
-    if (_cache->implementationMap.count(nodeDef))
+    vector<InterfaceElementPtr> matchingImplementations;
+    _cache->read([&](const Cache::Maps& maps)
     {
-        matchingImplementations.insert(matchingImplementations.end(), _cache->implementationMap.at(nodeDef).begin(), _cache->implementationMap.at(nodeDef).end());
+        auto it = maps.implementationMap.find(nodeDef);
+        if (it != maps.implementationMap.end())
+        {
+            matchingImplementations.insert(matchingImplementations.end(), it->second.begin(), it->second.end());
+        }
+    });
+
+    // Recurse to data library if present, skipping implementations that are
+    // shadowed by elements of this document.
+    if (hasDataLibrary())
+    {
+        for (InterfaceElementPtr impl : getDataLibrary()->getMatchingImplementations(nodeDef))
+        {
+            if (!getChild(impl->getQualifiedName(impl->getName())))
+            {
+                matchingImplementations.push_back(impl);
+            }
+        }
     }
 
     return matchingImplementations;
@@ -388,7 +646,65 @@ bool Document::validate(string* message) const
 
 void Document::invalidateCache()
 {
-    _cache->valid = false;
+    _cache->invalidate();
+}
+
+bool Document::findResolvedElement(const string& key, ElementPtr& elem) const
+{
+    const size_t editStamp = getEditStamp();
+    std::shared_lock<std::shared_mutex> lock(_cache->resolvedMutex);
+    if (_cache->resolvedEditStamp != editStamp)
+    {
+        return false;
+    }
+    auto it = _cache->resolvedElements.find(key);
+    if (it == _cache->resolvedElements.end())
+    {
+        return false;
+    }
+    elem = it->second;
+    return true;
+}
+
+void Document::addResolvedElement(const string& key, ElementPtr elem) const
+{
+    const size_t editStamp = getEditStamp();
+    std::unique_lock<std::shared_mutex> lock(_cache->resolvedMutex);
+    if (_cache->resolvedEditStamp != editStamp)
+    {
+        _cache->resolvedElements.clear();
+        _cache->resolvedEditStamp = editStamp;
+    }
+    _cache->resolvedElements[key] = elem;
+}
+
+void Document::invalidateResolvedElements()
+{
+    _cache->editStamp = newEditStamp();
+}
+
+size_t Document::getEditStamp() const
+{
+    // Edit stamps are unique and increasing across all documents, and
+    // changing the data library is itself an edit, so the latest stamp in
+    // the chain changes whenever any document in the chain does, and never
+    // returns to an earlier value.
+    size_t editStamp = _cache->editStamp;
+    if (_dataLibrary)
+    {
+        editStamp = std::max(editStamp, _dataLibrary->getEditStamp());
+    }
+    return editStamp;
+}
+
+void Document::addToCache(ElementPtr elem, bool recursive)
+{
+    _cache->add(elem, recursive);
+}
+
+void Document::removeFromCache(ElementPtr elem, bool recursive)
+{
+    _cache->remove(elem, recursive);
 }
 
 //
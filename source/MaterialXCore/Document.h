@@ -28,6 +28,10 @@ using ConstDocumentPtr = shared_ptr<const Document>;
 /// MaterialX ownership hierarchy.
 ///
 /// Use the factory function createDocument() to create a Document instance.
+///
+/// Lookups such as getMatchingNodeDefs and getMatchingImplementations may be
+/// called concurrently from multiple threads, provided that the document is
+/// not edited at the same time.
 class MX_CORE_API Document : public GraphElement
 {
   public:
@@ -61,10 +65,19 @@ class MX_CORE_API Document : public GraphElement
     /// @{
 
     /// Store a reference to a data library in this document.
-    void setDataLibrary(ConstDocumentPtr dataLibrary)
-    {
-        _dataLibrary = dataLibrary;
-    }
+    ///
+    /// A data library acts as a shared, read-only layer beneath the document,
+    /// whose definitions are visible to lookups such as getNodeDef,
+    /// getTypeDef, getImplementation, getMatchingNodeDefs and
+    /// getMatchingImplementations without being copied into the document.
+    /// Elements of the document take precedence over library elements of the
+    /// same name: they are listed first by lookups that return multiple
+    /// elements, and library elements that they shadow are omitted.  A data
+    /// library may itself reference a data library.
+    /// A single data library may be shared by any number of documents, and
+    /// these documents may be used concurrently from multiple threads,
+    /// provided that the data library is not edited at the same time.
+    void setDataLibrary(ConstDocumentPtr dataLibrary);
 
     /// Return true if this document has a data library.
     bool hasDataLibrary() const
@@ -683,7 +696,11 @@ class MX_CORE_API Document : public GraphElement
     /// @name Utility
     /// @{
 
-    /// Invalidate cached data for optimized lookups within the given document.
+    /// Invalidate cached data for optimized lookups within the given document,
+    /// forcing a full rebuild of the cache on the next lookup.
+    ///
+    /// Edits made through the Element API are applied to the cache incrementally,
+    /// so calling this method is not required after ordinary document edits.
     void invalidateCache();
 
     /// @}
@@ -700,6 +717,23 @@ class MX_CORE_API Document : public GraphElement
     static const string CMS_ATTRIBUTE;
     static const string CMS_CONFIG_ATTRIBUTE;
 
+  private:
+    friend class Element;
+    friend class Node;
+    friend class NodeDef;
+
+    // Incremental updates to the lookup cache, applied as elements and their
+    // cached attributes are edited.
+    void addToCache(ElementPtr elem, bool recursive);
+    void removeFromCache(ElementPtr elem, bool recursive);
+
+    // Memoized results of nodedef and implementation resolution, which are
+    // discarded on any edit to this document or to its data libraries.
+    bool findResolvedElement(const string& key, ElementPtr& elem) const;
+    void addResolvedElement(const string& key, ElementPtr elem) const;
+    void invalidateResolvedElements();
+    size_t getEditStamp() const;
+
   private:
     class Cache;
 
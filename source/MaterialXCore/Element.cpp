@@ -9,6 +9,7 @@
 #include <MaterialXCore/Util.h>
 
 #include <iterator>
+#include <string_view>
 
 MATERIALX_NAMESPACE_BEGIN
 
@@ -42,6 +43,32 @@ const string ValueElement::UNIFORM_ATTRIBUTE = "uniform";
 
 Element::CreatorMap Element::_creatorMap;
 
+namespace
+{
+
+// Return true if the given attribute contributes to the lookup cache of a document.
+bool isCachedAttribute(const string& attrib)
+{
+    return attrib == PortElement::NODE_NAME_ATTRIBUTE ||
+           attrib == PortElement::NODE_GRAPH_ATTRIBUTE ||
+           attrib == NodeDef::NODE_ATTRIBUTE ||
+           attrib == InterfaceElement::NODE_DEF_ATTRIBUTE ||
+           attrib == Element::NAMESPACE_ATTRIBUTE;
+}
+
+// Return true if the given attribute affects the resolution of nodedefs
+// and implementations, beyond the attributes held in the document cache.
+bool isResolutionAttribute(const string& attrib)
+{
+    return attrib == TypedElement::TYPE_ATTRIBUTE ||
+           attrib == InterfaceElement::TARGET_ATTRIBUTE ||
+           attrib == InterfaceElement::VERSION_ATTRIBUTE ||
+           attrib == InterfaceElement::DEFAULT_VERSION_ATTRIBUTE ||
+           attrib == Element::INHERIT_ATTRIBUTE;
+}
+
+} // anonymous namespace
+
 //
 // Element methods
 //
@@ -55,11 +82,13 @@ bool Element::operator==(const Element& rhs) const
     }
 
     // Compare attributes.
-    if (getAttributeNames() != rhs.getAttributeNames())
+    if (_attributes.size() != rhs._attributes.size())
         return false;
-    for (const string& attr : rhs.getAttributeNames())
+    for (size_t i = 0; i < _attributes.size(); i++)
     {
-        if (getAttribute(attr) != rhs.getAttribute(attr))
+        if (_attributes[i].knownName != rhs._attributes[i].knownName ||
+            _attributes[i].name != rhs._attributes[i].name ||
+            _attributes[i].value != rhs._attributes[i].value)
             return false;
     }
 
@@ -89,14 +118,15 @@ void Element::setName(const string& name)
         throw Exception("Element name is not unique at the given scope: " + name);
     }
 
-    getDocument()->invalidateCache();
-
     if (parent)
     {
         parent->_childMap.erase(getName());
         parent->_childMap[name] = getSelf();
     }
     _name = name;
+
+    // Resolution matches on the names of elements, such as nodedef inputs.
+    invalidateResolvedElements();
 }
 
 string Element::getNamePath(ConstElementPtr relativeTo) const
@@ -135,15 +165,15 @@ ElementPtr Element::getDescendant(const string& namePath) const
 
 void Element::registerChildElement(ElementPtr child)
 {
-    getDocument()->invalidateCache();
-
     _childMap[child->getName()] = child;
     _childOrder.push_back(child);
+
+    getDocument()->addToCache(child, true);
 }
 
 void Element::unregisterChildElement(ElementPtr child)
 {
-    getDocument()->invalidateCache();
+    getDocument()->removeFromCache(child, true);
 
     _childMap.erase(child->getName());
     _childOrder.erase(
@@ -192,28 +222,134 @@ void Element::removeChild(const string& name)
 
 void Element::setAttribute(const string& attrib, const string& value)
 {
-    getDocument()->invalidateCache();
+    // A namespace change affects the qualified names of all descendants.
+    DocumentPtr doc = (isCachedAttribute(attrib) && getAttribute(attrib) != value) ? getDocument() : nullptr;
+    const bool recursive = (attrib == NAMESPACE_ATTRIBUTE);
+    const bool resolutionEdit = isResolutionAttribute(attrib) && getAttribute(attrib) != value;
+    if (doc)
+    {
+        doc->removeFromCache(getSelf(), recursive);
+    }
+
+    const Attribute* attr = findAttribute(attrib);
+    if (attr)
+    {
+        _attributes[attr - _attributes.data()].value = value;
+    }
+    else
+    {
+        const string* knownName = findKnownAttributeName(attrib);
+        _attributes.push_back({ knownName, knownName ? EMPTY_STRING : attrib, value });
+    }
 
-    if (!_attributeMap.count(attrib))
+    if (doc)
     {
-        _attributeOrder.push_back(attrib);
+        doc->addToCache(getSelf(), recursive);
     }
-    _attributeMap[attrib] = value;
+    if (resolutionEdit)
+    {
+        invalidateResolvedElements();
+    }
+    onAttributeChanged(attrib);
 }
 
 void Element::removeAttribute(const string& attrib)
 {
-    StringMap::iterator it = _attributeMap.find(attrib);
-    if (it != _attributeMap.end())
+    const Attribute* attr = findAttribute(attrib);
+    if (attr)
     {
-        getDocument()->invalidateCache();
+        DocumentPtr doc = isCachedAttribute(attrib) ? getDocument() : nullptr;
+        const bool recursive = (attrib == NAMESPACE_ATTRIBUTE);
+        if (doc)
+        {
+            doc->removeFromCache(getSelf(), recursive);
+        }
+
+        _attributes.erase(_attributes.begin() + (attr - _attributes.data()));
+
+        if (doc)
+        {
+            doc->addToCache(getSelf(), recursive);
+        }
+        if (isResolutionAttribute(attrib))
+        {
+            invalidateResolvedElements();
+        }
+        onAttributeChanged(attrib);
+    }
+}
 
-        _attributeMap.erase(it);
-        _attributeOrder.erase(
-            std::find(_attributeOrder.begin(), _attributeOrder.end(), attrib));
+void Element::invalidateResolvedElements()
+{
+    DocumentPtr doc = getDocument();
+    if (doc)
+    {
+        doc->invalidateResolvedElements();
     }
 }
 
+const string* Element::findKnownAttributeName(const string& attrib)
+{
+    // The table holds only the names defined by the MaterialX specification,
+    // and is never modified after initialization, so lookups by other names
+    // neither lock nor allocate.
+    static const std::unordered_map<std::string_view, const string*> names = []()
+    {
+        std::unordered_map<std::string_view, const string*> table;
+        for (const string* name : { &TypedElement::TYPE_ATTRIBUTE,
+                                    &ValueElement::VALUE_ATTRIBUTE,
+                                    &PortElement::NODE_NAME_ATTRIBUTE,
+                                    &PortElement::NODE_GRAPH_ATTRIBUTE,
+                                    &PortElement::OUTPUT_ATTRIBUTE,
+                                    &ValueElement::INTERFACE_NAME_ATTRIBUTE,
+                                    &InterfaceElement::NODE_DEF_ATTRIBUTE,
+                                    &InterfaceElement::TARGET_ATTRIBUTE,
+                                    &InterfaceElement::VERSION_ATTRIBUTE,
+                                    &InterfaceElement::DEFAULT_VERSION_ATTRIBUTE,
+                                    &Element::COLOR_SPACE_ATTRIBUTE,
+                                    &Element::FILE_PREFIX_ATTRIBUTE,
+                                    &Element::GEOM_PREFIX_ATTRIBUTE,
+                                    &Element::INHERIT_ATTRIBUTE,
+                                    &Element::NAMESPACE_ATTRIBUTE,
+                                    &Element::DOC_ATTRIBUTE,
+                                    &Element::XPOS_ATTRIBUTE,
+                                    &Element::YPOS_ATTRIBUTE,
+                                    &ValueElement::ENUM_ATTRIBUTE,
+                                    &ValueElement::ENUM_VALUES_ATTRIBUTE,
+                                    &ValueElement::IMPLEMENTATION_NAME_ATTRIBUTE,
+                                    &ValueElement::IMPLEMENTATION_TYPE_ATTRIBUTE,
+                                    &ValueElement::UI_NAME_ATTRIBUTE,
+                                    &ValueElement::UI_FOLDER_ATTRIBUTE,
+                                    &ValueElement::UI_MIN_ATTRIBUTE,
+                                    &ValueElement::UI_MAX_ATTRIBUTE,
+                                    &ValueElement::UI_SOFT_MIN_ATTRIBUTE,
+                                    &ValueElement::UI_SOFT_MAX_ATTRIBUTE,
+                                    &ValueElement::UI_STEP_ATTRIBUTE,
+                                    &ValueElement::UI_ADVANCED_ATTRIBUTE,
+                                    &ValueElement::UNIT_ATTRIBUTE,
+                                    &ValueElement::UNITTYPE_ATTRIBUTE,
+                                    &ValueElement::UNIFORM_ATTRIBUTE,
+                                    &Input::DEFAULT_GEOM_PROP_ATTRIBUTE,
+                                    &Input::HINT_ATTRIBUTE,
+                                    &Output::DEFAULT_INPUT_ATTRIBUTE,
+                                    &GeomElement::GEOM_ATTRIBUTE,
+                                    &GeomElement::COLLECTION_ATTRIBUTE,
+                                    &NodeDef::NODE_ATTRIBUTE,
+                                    &NodeDef::NODE_GROUP_ATTRIBUTE,
+                                    &Implementation::FILE_ATTRIBUTE,
+                                    &Implementation::FUNCTION_ATTRIBUTE,
+                                    &Document::CMS_ATTRIBUTE,
+                                    &Document::CMS_CONFIG_ATTRIBUTE })
+        {
+            table.emplace(*name, name);
+        }
+        return table;
+    }();
+
+    auto it = names.find(attrib);
+    return (it != names.end()) ? it->second : nullptr;
+}
+
 template <class T> shared_ptr<T> Element::asA()
 {
     return std::dynamic_pointer_cast<T>(getSelf());
@@ -280,15 +416,17 @@ ElementPtr Element::changeChildCategory(ElementPtr child, const string& category
 
 template <class T> shared_ptr<T> Element::getChildOfType(const string& name) const
 {
-    ElementPtr child;
-    ConstDocumentPtr doc = asA<Document>();
-    if (doc && doc->hasDataLibrary())
-    {
-        child = doc->getDataLibrary()->getChild(name);
-    }
+    // Elements of a document take precedence over those of its data library,
+    // matching the behavior of Document::importLibrary, and data libraries
+    // may themselves reference further data libraries.
+    ElementPtr child = getChild(name);
     if (!child)
     {
-        child = getChild(name);
+        ConstDocumentPtr doc = asA<Document>();
+        if (doc && doc->hasDataLibrary())
+        {
+            child = doc->getDataLibrary()->getChildOfType<Element>(name);
+        }
     }
     return child ? child->asA<T>() : shared_ptr<T>();
 }
@@ -296,11 +434,6 @@ template <class T> shared_ptr<T> Element::getChildOfType(const string& name) con
 template <class T> vector<shared_ptr<T>> Element::getChildrenOfType(const string& category) const
 {
     vector<shared_ptr<T>> children;
-    ConstDocumentPtr doc = asA<Document>();
-    if (doc && doc->hasDataLibrary())
-    {
-        children = doc->getDataLibrary()->getChildrenOfType<T>(category);
-    }
     for (ElementPtr child : _childOrder)
     {
         shared_ptr<T> instance = child->asA<T>();
@@ -310,6 +443,20 @@ template <class T> vector<shared_ptr<T>> Element::getChildrenOfType(const string
             continue;
         children.push_back(instance);
     }
+
+    // Children of a document precede those of its data library, and shadow
+    // library children of the same name.
+    ConstDocumentPtr doc = asA<Document>();
+    if (doc && doc->hasDataLibrary())
+    {
+        for (shared_ptr<T> libraryChild : doc->getDataLibrary()->getChildrenOfType<T>(category))
+        {
+            if (!getChild(libraryChild->getQualifiedName(libraryChild->getName())))
+            {
+                children.push_back(libraryChild);
+            }
+        }
+    }
     return children;
 }
 
@@ -524,11 +671,14 @@ InheritanceIterator Element::traverseInheritance() const
 
 void Element::copyContentFrom(const ConstElementPtr& source)
 {
-    getDocument()->invalidateCache();
+    DocumentPtr doc = getDocument();
+    doc->removeFromCache(getSelf(), true);
 
     _sourceUri = source->_sourceUri;
-    _attributeMap = source->_attributeMap;
-    _attributeOrder = source->_attributeOrder;
+    _attributes = source->_attributes;
+    onAttributeChanged(EMPTY_STRING);
+
+    doc->addToCache(getSelf(), true);
 
     for (auto child : source->getChildren())
     {
@@ -549,11 +699,11 @@ void Element::copyContentFrom(const ConstElementPtr& source)
 
 void Element::clearContent()
 {
-    getDocument()->invalidateCache();
+    getDocument()->removeFromCache(getSelf(), true);
 
     _sourceUri.clear();
-    _attributeMap.clear();
-    _attributeOrder.clear();
+    _attributes.clear();
+    onAttributeChanged(EMPTY_STRING);
     _childMap.clear();
     _childOrder.clear();
 }
@@ -612,9 +762,9 @@ string Element::asString() const
     {
         res += " name=\"" + getName() + "\"";
     }
-    for (const string& attrName : getAttributeNames())
+    for (const Attribute& attr : _attributes)
     {
-        res += " " + attrName + "=\"" + getAttribute(attrName) + "\"";
+        res += " " + attr.getName() + "=\"" + attr.value + "\"";
     }
     res += ">";
     return res;
@@ -660,20 +810,40 @@ string ValueElement::getResolvedValueString(StringResolverPtr resolver) const
 
 ValuePtr ValueElement::getValue() const
 {
+    ConstValuePtr cached = std::atomic_load(&_value);
+    if (cached)
+        return cached->copy();
     if (!hasValue())
         return ValuePtr();
 
-    return Value::createValueFromStrings(getValueString(), getType(), getDocument()->getTypeDef(getType()));
+    // Aggregate values depend on type definitions elsewhere in the document,
+    // so only values of registered types are cached.
+    ValuePtr value = Value::createValueFromStrings(getValueString(), getType(), getDocument()->getTypeDef(getType()));
+    if (value && !value->isA<AggregateValue>())
+    {
+        std::atomic_store(&_value, ConstValuePtr(value->copy()));
+    }
+    return value;
 }
 
 ValuePtr ValueElement::getResolvedValue(StringResolverPtr resolver) const
 {
     if (!hasValue())
         return ValuePtr();
+    if (!StringResolver::isResolvedType(getType()))
+        return getValue();
 
     return Value::createValueFromStrings(getResolvedValueString(resolver), getType(), getDocument()->getTypeDef(getType()));
 }
 
+void ValueElement::onAttributeChanged(const string& attrib)
+{
+    if (attrib.empty() || attrib == VALUE_ATTRIBUTE || attrib == TYPE_ATTRIBUTE)
+    {
+        std::atomic_store(&_value, ConstValuePtr());
+    }
+}
+
 ValuePtr ValueElement::getDefaultValue() const
 {
     ConstElementPtr parent = getParent();
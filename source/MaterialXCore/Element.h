@@ -484,21 +484,47 @@ class MX_CORE_API Element : public std::enable_shared_from_this<Element>
     /// Return true if the given attribute is present.
     bool hasAttribute(const string& attrib) const
     {
-        return _attributeMap.count(attrib) != 0;
+        return findAttribute(attrib) != nullptr;
     }
 
     /// Return the value string of the given attribute.  If the given attribute
     /// is not present, then an empty string is returned.
     const string& getAttribute(const string& attrib) const
     {
-        StringMap::const_iterator it = _attributeMap.find(attrib);
-        return (it != _attributeMap.end()) ? it->second : EMPTY_STRING;
+        const Attribute* attr = findAttribute(attrib);
+        return attr ? attr->value : EMPTY_STRING;
     }
 
     /// Return a vector of stored attribute names, in the order they were set.
-    const StringVec& getAttributeNames() const
+    StringVec getAttributeNames() const
     {
-        return _attributeOrder;
+        StringVec names;
+        names.reserve(_attributes.size());
+        for (const Attribute& attr : _attributes)
+        {
+            names.push_back(attr.getName());
+        }
+        return names;
+    }
+
+    /// Return the number of stored attributes.
+    size_t getAttributeCount() const
+    {
+        return _attributes.size();
+    }
+
+    /// Return the name of the attribute at the given index, in the order
+    /// that attributes were set.
+    const string& getAttributeName(size_t index) const
+    {
+        return _attributes[index].getName();
+    }
+
+    /// Return the value string of the attribute at the given index, in the
+    /// order that attributes were set.
+    const string& getAttributeValue(size_t index) const
+    {
+        return _attributes[index].value;
     }
 
     /// Set the value of an implicitly typed attribute.  Since an attribute
@@ -827,6 +853,10 @@ class MX_CORE_API Element : public std::enable_shared_from_this<Element>
     virtual void registerChildElement(ElementPtr child);
     virtual void unregisterChildElement(ElementPtr child);
 
+    // Called after the given attribute of this element is set or removed,
+    // or with an empty name after all attributes are replaced.
+    virtual void onAttributeChanged(const string&) { }
+
     // Return a non-const copy of our self pointer, for use in constructing
     // graph traversal objects that require non-const storage.
     ElementPtr getSelfNonConst() const
@@ -842,13 +872,58 @@ class MX_CORE_API Element : public std::enable_shared_from_this<Element>
     ElementMap _childMap;
     ElementVec _childOrder;
 
-    StringMap _attributeMap;
-    StringVec _attributeOrder;
+    // Attribute values paired with their names, in the order that they were
+    // set.  Well-known names refer to their static constants, while other
+    // names are stored inline.  Since elements hold only a handful of
+    // attributes, a linear search of this vector is faster than a hash lookup.
+    struct Attribute
+    {
+        const string& getName() const
+        {
+            return knownName ? *knownName : name;
+        }
+
+        const string* knownName;
+        string name;
+        string value;
+    };
+    vector<Attribute> _attributes;
 
     weak_ptr<Element> _parent;
     weak_ptr<Element> _root;
 
   private:
+    // Well-known attribute names refer to their static constants, so
+    // queries by those constants match by address.  Names are compared only
+    // for other queries, or when no attribute matches by address.
+    const Attribute* findAttribute(const string& attrib) const
+    {
+        for (const Attribute& attr : _attributes)
+        {
+            if (attr.knownName == &attrib)
+            {
+                return &attr;
+            }
+        }
+        for (const Attribute& attr : _attributes)
+        {
+            if (attr.getName() == attrib)
+            {
+                return &attr;
+            }
+        }
+        return nullptr;
+    }
+
+    // Return the static constant for the given well-known attribute name,
+    // or nullptr if the name is not a well-known attribute of the MaterialX
+    // specification.
+    static const string* findKnownAttributeName(const string& attrib);
+
+    // Discard memoized nodedef and implementation resolutions after an edit
+    // to an attribute they depend upon.
+    void invalidateResolvedElements();
+
     template <class T> static ElementPtr createElement(ElementPtr parent, const string& name)
     {
         return std::make_shared<T>(parent, name);
@@ -1036,10 +1111,40 @@ class MX_CORE_API ValueElement : public TypedElement
     /// Return the typed value of an element as a generic value object, which
     /// may be queried to access its data.
     ///
+    /// The parsed value is cached on the element until its value or type
+    /// is next modified, and each call returns a new copy of the cached
+    /// value, so edits to the returned object do not affect the element.
+    ///
     /// @return A shared pointer to the typed value of this element, or an
     ///    empty shared pointer if no value is present.
     ValuePtr getValue() const;
 
+    /// Return the typed value of an element as data of the given type,
+    /// without allocating a generic value object.
+    ///
+    /// @return The typed value of this element, or a default-constructed
+    ///    value if no value of the given type is present.
+    template <class T> T getTypedValue() const
+    {
+        ConstValuePtr value = std::atomic_load(&_value);
+        if (value)
+        {
+            return value->isA<T>() ? value->asA<T>() : T();
+        }
+        if (!hasValue() || getType() != getTypeString<T>())
+        {
+            return T();
+        }
+        try
+        {
+            return fromValueString<T>(getValueString());
+        }
+        catch (ExceptionTypeError&)
+        {
+        }
+        return T();
+    }
+
     /// Return the resolved value of an element as a generic value object, which
     /// may be queried to access its data.
     ///
@@ -1160,6 +1265,12 @@ class MX_CORE_API ValueElement : public TypedElement
     static const string UNIT_ATTRIBUTE;
     static const string UNITTYPE_ATTRIBUTE;
     static const string UNIFORM_ATTRIBUTE;
+
+  protected:
+    void onAttributeChanged(const string& attrib) override;
+
+  private:
+    mutable ConstValuePtr _value;
 };
 
 /// @class Token
@@ -7,6 +7,9 @@
 
 #include <MaterialXCore/Document.h>
 
+#include <algorithm>
+#include <set>
+
 MATERIALX_NAMESPACE_BEGIN
 
 const string MaterialAssign::MATERIAL_ATTRIBUTE = "material";
@@ -115,6 +118,292 @@ vector<VisibilityPtr> Look::getActiveVisibilities() const
     return activeVisibilities;
 }
 
+//
+// LookIndex methods
+//
+
+// A node in the trie of geometry path components, holding the assignments
+// and collections whose geom strings include the path to this node.
+struct LookIndex::TrieNode
+{
+    std::unordered_map<string, size_t> children;
+    vector<size_t> assigns;
+    vector<size_t> includeCollections;
+    vector<size_t> excludeCollections;
+
+    // Collections with include geoms in the strict descendants of this node.
+    vector<size_t> subtreeIncludeCollections;
+};
+
+// Scratch state for resolving geometry strings, reused across queries.
+class LookIndex::State
+{
+  public:
+    explicit State(size_t collectionCount) :
+        included(collectionCount, false),
+        excluded(collectionCount, false),
+        matched(collectionCount, false)
+    {
+    }
+
+    void reset()
+    {
+        std::fill(included.begin(), included.end(), false);
+        std::fill(excluded.begin(), excluded.end(), false);
+        std::fill(matched.begin(), matched.end(), false);
+        assigns.clear();
+    }
+
+    vector<bool> included;
+    vector<bool> excluded;
+    vector<bool> matched;
+    vector<size_t> assigns;
+};
+
+LookIndex::LookIndex()
+{
+    _nodes.emplace_back();
+}
+
+LookIndex::~LookIndex()
+{
+}
+
+LookIndexPtr LookIndex::create(const vector<LookPtr>& looks)
+{
+    LookIndexPtr index(new LookIndex());
+
+    // Gather the active assignments of each look, skipping assignments
+    // that are shared through look inheritance.
+    std::set<ElementPtr> visited;
+    auto addAssigns = [&](const auto& assigns, auto getGeom)
+    {
+        for (const auto& assign : assigns)
+        {
+            if (visited.insert(assign).second)
+            {
+                index->addAssign(assign, getGeom(assign), assign->getCollection());
+            }
+        }
+    };
+    auto getActiveGeom = [](const auto& assign) { return assign->getActiveGeom(); };
+    for (LookPtr look : looks)
+    {
+        addAssigns(look->getActiveMaterialAssigns(), getActiveGeom);
+        addAssigns(look->getActivePropertyAssigns(), [](PropertyAssignPtr assign) { return assign->getGeom(); });
+        addAssigns(look->getActivePropertySetAssigns(), getActiveGeom);
+        addAssigns(look->getActiveVisibilities(), getActiveGeom);
+    }
+
+    // Gather the collections with include geoms below each node, visiting
+    // children before their parents.
+    for (size_t i = index->_nodes.size(); i-- > 0;)
+    {
+        for (const auto& child : index->_nodes[i].children)
+        {
+            const TrieNode& childNode = index->_nodes[child.second];
+            vector<size_t>& subtree = index->_nodes[i].subtreeIncludeCollections;
+            subtree.insert(subtree.end(), childNode.includeCollections.begin(), childNode.includeCollections.end());
+            subtree.insert(subtree.end(), childNode.subtreeIncludeCollections.begin(), childNode.subtreeIncludeCollections.end());
+        }
+        vector<size_t>& subtree = index->_nodes[i].subtreeIncludeCollections;
+        std::sort(subtree.begin(), subtree.end());
+        subtree.erase(std::unique(subtree.begin(), subtree.end()), subtree.end());
+    }
+    return index;
+}
+
+LookIndexPtr LookIndex::create(ConstDocumentPtr doc)
+{
+    return create(doc->getLooks());
+}
+
+LookAssignments LookIndex::getAssignments(const string& geom) const
+{
+    State state(_collections.size());
+    LookAssignments assignments;
+    resolve(geom, state, assignments);
+    return assignments;
+}
+
+vector<LookAssignments> LookIndex::getAssignments(const StringVec& geoms) const
+{
+    State state(_collections.size());
+    vector<LookAssignments> assignments(geoms.size());
+    for (size_t i = 0; i < geoms.size(); i++)
+    {
+        resolve(geoms[i], state, assignments[i]);
+    }
+    return assignments;
+}
+
+size_t LookIndex::addPath(const string& path)
+{
+    size_t node = 0;
+    for (const string& name : splitString(path, GEOM_PATH_SEPARATOR))
+    {
+        auto it = _nodes[node].children.find(name);
+        if (it != _nodes[node].children.end())
+        {
+            node = it->second;
+            continue;
+        }
+        size_t child = _nodes.size();
+        _nodes[node].children[name] = child;
+        _nodes.emplace_back();
+        node = child;
+    }
+    return node;
+}
+
+void LookIndex::addAssign(ElementPtr assign, const string& geom, CollectionPtr collection)
+{
+    size_t index = _assigns.size();
+    _assigns.push_back(assign);
+
+    for (const string& path : splitString(geom, ARRAY_VALID_SEPARATORS))
+    {
+        _nodes[addPath(path)].assigns.push_back(index);
+    }
+    if (collection)
+    {
+        _collectionAssigns[addCollection(collection)].push_back(index);
+    }
+}
+
+size_t LookIndex::addCollection(CollectionPtr collection)
+{
+    auto it = _collectionIndices.find(collection);
+    if (it != _collectionIndices.end())
+    {
+        return it->second;
+    }
+
+    size_t index = _collections.size();
+    _collections.push_back(collection);
+    _collectionIndices[collection] = index;
+    _collectionClosures.emplace_back();
+    _collectionAssigns.emplace_back();
+
+    for (const string& path : splitString(collection->getActiveIncludeGeom(), ARRAY_VALID_SEPARATORS))
+    {
+        _nodes[addPath(path)].includeCollections.push_back(index);
+    }
+    for (const string& path : splitString(collection->getActiveExcludeGeom(), ARRAY_VALID_SEPARATORS))
+    {
+        _nodes[addPath(path)].excludeCollections.push_back(index);
+    }
+
+    // Expand the include chain as Collection::matchesGeomString does, adding
+    // included collections to the order before the collections that include them.
+    std::set<CollectionPtr> includedSet;
+    vector<CollectionPtr> includedVec = collection->getIncludeCollections();
+    for (size_t i = 0; i < includedVec.size(); i++)
+    {
+        CollectionPtr included = includedVec[i];
+        if (includedSet.count(included))
+        {
+            throw ExceptionFoundCycle("Encountered a cycle in collection: " + collection->getName());
+        }
+        includedSet.insert(included);
+        vector<CollectionPtr> appendVec = included->getIncludeCollections();
+        includedVec.insert(includedVec.end(), appendVec.begin(), appendVec.end());
+    }
+    vector<size_t> closure;
+    for (CollectionPtr included : includedSet)
+    {
+        closure.push_back(addCollection(included));
+    }
+    _collectionClosures[index] = closure;
+    _collectionOrder.push_back(index);
+
+    return index;
+}
+
+void LookIndex::resolve(const string& geom, State& state, LookAssignments& assignments) const
+{
+    state.reset();
+
+    // Walk the trie along each path, gathering the assignments and
+    // collections whose geom strings contain a prefix of the path, along
+    // with the collections that include geometry below the path.
+    for (const string& path : splitString(geom, ARRAY_VALID_SEPARATORS))
+    {
+        size_t node = 0;
+        StringVec names = splitString(path, GEOM_PATH_SEPARATOR);
+        for (size_t depth = 0; ; depth++)
+        {
+            const TrieNode& trieNode = _nodes[node];
+            state.assigns.insert(state.assigns.end(), trieNode.assigns.begin(), trieNode.assigns.end());
+            for (size_t collection : trieNode.includeCollections)
+            {
+                state.included[collection] = true;
+            }
+            for (size_t collection : trieNode.excludeCollections)
+            {
+                state.excluded[collection] = true;
+            }
+            if (depth == names.size())
+            {
+                for (size_t collection : trieNode.subtreeIncludeCollections)
+                {
+                    state.included[collection] = true;
+                }
+                break;
+            }
+            auto it = trieNode.children.find(names[depth]);
+            if (it == trieNode.children.end())
+            {
+                break;
+            }
+            node = it->second;
+        }
+    }
+
+    // Evaluate collections after the collections that they include.
+    for (size_t collection : _collectionOrder)
+    {
+        if (state.excluded[collection])
+        {
+            continue;
+        }
+        bool matched = state.included[collection];
+        for (size_t i = 0; !matched && i < _collectionClosures[collection].size(); i++)
+        {
+            matched = state.matched[_collectionClosures[collection][i]];
+        }
+        if (matched)
+        {
+            state.matched[collection] = true;
+            state.assigns.insert(state.assigns.end(), _collectionAssigns[collection].begin(), _collectionAssigns[collection].end());
+        }
+    }
+
+    // Return the matching assignments in their original order.
+    std::sort(state.assigns.begin(), state.assigns.end());
+    state.assigns.erase(std::unique(state.assigns.begin(), state.assigns.end()), state.assigns.end());
+    for (size_t index : state.assigns)
+    {
+        const ElementPtr& assign = _assigns[index];
+        if (MaterialAssignPtr materialAssign = assign->asA<MaterialAssign>())
+        {
+            assignments.materialAssigns.push_back(materialAssign);
+        }
+        else if (PropertyAssignPtr propertyAssign = assign->asA<PropertyAssign>())
+        {
+            assignments.propertyAssigns.push_back(propertyAssign);
+        }
+        else if (PropertySetAssignPtr propertySetAssign = assign->asA<PropertySetAssign>())
+        {
+            assignments.propertySetAssigns.push_back(propertySetAssign);
+        }
+        else if (VisibilityPtr visibility = assign->asA<Visibility>())
+        {
+            assignments.visibilities.push_back(visibility);
+        }
+    }
+}
+
 //
 // MaterialAssign methods
 //
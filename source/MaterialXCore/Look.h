@@ -17,8 +17,10 @@
 
 MATERIALX_NAMESPACE_BEGIN
 
+class Document;
 class Look;
 class LookGroup;
+class LookIndex;
 class LookInherit;
 class MaterialAssign;
 class Visibility;
@@ -33,6 +35,11 @@ using LookGroupPtr = shared_ptr<LookGroup>;
 /// A shared pointer to a const LookGroup
 using ConstLookGroupPtr = shared_ptr<const LookGroup>;
 
+/// A shared pointer to a LookIndex
+using LookIndexPtr = shared_ptr<LookIndex>;
+/// A shared pointer to a const LookIndex
+using ConstLookIndexPtr = shared_ptr<const LookIndex>;
+
 /// A shared pointer to a MaterialAssign
 using MaterialAssignPtr = shared_ptr<MaterialAssign>;
 /// A shared pointer to a const MaterialAssign
@@ -488,6 +495,83 @@ class MX_CORE_API Visibility : public GeomElement
     static const string VISIBLE_ATTRIBUTE;
 };
 
+/// @class LookAssignments
+/// The assignment elements of a set of looks that apply to a geometry.
+class MX_CORE_API LookAssignments
+{
+  public:
+    vector<MaterialAssignPtr> materialAssigns;
+    vector<PropertyAssignPtr> propertyAssigns;
+    vector<PropertySetAssignPtr> propertySetAssigns;
+    vector<VisibilityPtr> visibilities;
+};
+
+/// @class LookIndex
+/// A prebuilt index of the assignment elements in a set of looks, which
+/// answers which assignments apply to a given geometry.
+///
+/// The active geom strings of assignments and collections are stored in a
+/// trie of geometry path components, and the include chains of collections
+/// are expanded when the index is built, so that resolving the assignments
+/// for a geometry path takes time proportional to the depth of the path.
+///
+/// An assignment applies to a geometry when its active geom string contains
+/// the geometry, or when its collection matches the geometry, following the
+/// rules of geomStringsMatch and Collection::matchesGeomString.
+///
+/// The index is an immutable snapshot, which may be queried concurrently,
+/// and which should be rebuilt after the looks or their collections are edited.
+class MX_CORE_API LookIndex
+{
+  public:
+    /// Build an index of the active assignments of the given looks.
+    /// @throws ExceptionFoundCycle if the include chain of a collection
+    ///    contains a cycle.
+    static LookIndexPtr create(const vector<LookPtr>& looks);
+
+    /// Build an index of the active assignments of all looks in the given document.
+    /// @throws ExceptionFoundCycle if the include chain of a collection
+    ///    contains a cycle.
+    static LookIndexPtr create(shared_ptr<const Document> doc);
+
+    ~LookIndex();
+
+    /// Return the assignments that apply to the given geometry string, in
+    /// the order of the looks and their assignments.
+    LookAssignments getAssignments(const string& geom) const;
+
+    /// Return the assignments that apply to each of the given geometry
+    /// strings, reusing intermediate state across the whole list.
+    vector<LookAssignments> getAssignments(const StringVec& geoms) const;
+
+    /// Return the number of assignment elements held in the index.
+    size_t getAssignmentCount() const
+    {
+        return _assigns.size();
+    }
+
+  protected:
+    LookIndex();
+
+  private:
+    class State;
+    struct TrieNode;
+
+    size_t addPath(const string& path);
+    void addAssign(ElementPtr assign, const string& geom, CollectionPtr collection);
+    size_t addCollection(CollectionPtr collection);
+    void resolve(const string& geom, State& state, LookAssignments& assignments) const;
+
+  private:
+    vector<ElementPtr> _assigns;
+    vector<TrieNode> _nodes;
+    vector<CollectionPtr> _collections;
+    std::unordered_map<CollectionPtr, size_t> _collectionIndices;
+    vector<vector<size_t>> _collectionClosures;
+    vector<vector<size_t>> _collectionAssigns;
+    vector<size_t> _collectionOrder;
+};
+
 /// Return a vector of all MaterialAssign elements that bind this material node
 /// to the given geometry string
 /// @param materialNode Node to examine
@@ -85,9 +85,27 @@ NodeDefPtr Node::getNodeDef(const string& target, bool allowRoughMatch) const
     {
         return resolveNameReference<NodeDef>(getNodeDefString());
     }
-    vector<NodeDefPtr> nodeDefs = getDocument()->getMatchingNodeDefs(getQualifiedName(getCategory()));
-    vector<NodeDefPtr> secondary = getDocument()->getMatchingNodeDefs(getCategory());
+
+    // Memoize the match for the signature of this node, since shader
+    // generation resolves the same signatures for many nodes.
+    ConstDocumentPtr doc = getDocument();
+    const string qualifiedCategory = getQualifiedName(getCategory());
+    string signature = "nodedef\n" + qualifiedCategory + "\n" + getCategory() + "\n" + getType() + "\n" +
+                       target + "\n" + getVersionString() + "\n" + (allowRoughMatch ? "1" : "0") + "\n";
+    for (InputPtr input : getActiveInputs())
+    {
+        signature += input->getName() + " " + input->getType() + "\n";
+    }
+    ElementPtr resolved;
+    if (doc->findResolvedElement(signature, resolved))
+    {
+        return resolved ? resolved->asA<NodeDef>() : nullptr;
+    }
+
+    vector<NodeDefPtr> nodeDefs = doc->getMatchingNodeDefs(qualifiedCategory);
+    vector<NodeDefPtr> secondary = doc->getMatchingNodeDefs(getCategory());
     vector<NodeDefPtr> roughMatches;
+    NodeDefPtr match;
     nodeDefs.insert(nodeDefs.end(), secondary.begin(), secondary.end());
     for (NodeDefPtr nodeDef : nodeDefs)
     {
@@ -105,13 +123,16 @@ NodeDefPtr Node::getNodeDef(const string& target, bool allowRoughMatch) const
             }
             continue;
         }
-        return nodeDef;
+        match = nodeDef;
+        break;
     }
-    if (!roughMatches.empty())
+    if (!match && !roughMatches.empty())
     {
-        return roughMatches[0];
+        match = roughMatches[0];
     }
-    return NodeDefPtr();
+
+    doc->addResolvedElement(signature, match);
+    return match;
 }
 
 Edge Node::getUpstreamEdge(size_t index) const
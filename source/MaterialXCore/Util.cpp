@@ -5,7 +5,11 @@
 
 #include <MaterialXCore/Types.h>
 
+#include <atomic>
 #include <cctype>
+#include <exception>
+#include <system_error>
+#include <thread>
 
 MATERIALX_NAMESPACE_BEGIN
 
@@ -179,4 +183,72 @@ string parentNamePath(const string& namePath)
     return EMPTY_STRING;
 }
 
+unsigned int getParallelWorkerCount(size_t count, unsigned int threadCount)
+{
+    if (threadCount == 0)
+    {
+        static const unsigned int hardwareThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        threadCount = hardwareThreadCount;
+    }
+    return (unsigned int) std::max(std::min((size_t) threadCount, count), (size_t) 1);
+}
+
+void parallelFor(size_t count, unsigned int threadCount, const std::function<void(size_t, unsigned int)>& func)
+{
+    unsigned int workerCount = getParallelWorkerCount(count, threadCount);
+    if (workerCount <= 1)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            func(i, 0);
+        }
+        return;
+    }
+
+    vector<std::exception_ptr> errors(count);
+    std::atomic<size_t> nextIndex(0);
+    auto processIndices = [&](unsigned int worker)
+    {
+        for (size_t i = nextIndex++; i < count; i = nextIndex++)
+        {
+            try
+            {
+                func(i, worker);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    vector<std::thread> threads;
+    for (unsigned int worker = 1; worker < workerCount; worker++)
+    {
+        try
+        {
+            threads.emplace_back(processIndices, worker);
+        }
+        catch (std::system_error&)
+        {
+            // Continue with the threads that could be created.
+            break;
+        }
+    }
+    processIndices(0);
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Report the first error in index order.
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
 MATERIALX_NAMESPACE_END
@@ -69,6 +69,28 @@ MX_CORE_API string createNamePath(const StringVec& nameVec);
 /// Given a name path, return the parent name path
 MX_CORE_API string parentNamePath(const string& namePath);
 
+/// Call the given function for each index in the range [0, count),
+/// distributing indices across threads.  This helper is shared by the
+/// multi-threaded operations of MaterialX libraries.
+///
+/// A thread count of zero selects the number of hardware threads, and a
+/// thread count of one calls the function for each index in order on the
+/// calling thread.  If fewer threads can be created than requested, the
+/// remaining work is shared by the threads that were created.
+///
+/// The function is also passed the index of the worker that calls it, in
+/// the range [0, threadCount), so that callers may keep state per worker.
+/// The calling thread is always worker zero.
+///
+/// Exceptions thrown by the function are captured, and once all indices
+/// have been processed, the exception for the lowest index is rethrown.
+MX_CORE_API void parallelFor(size_t count, unsigned int threadCount,
+                             const std::function<void(size_t index, unsigned int worker)>& func);
+
+/// Return the number of workers that parallelFor would use for the given
+/// count and thread count.
+MX_CORE_API unsigned int getParallelWorkerCount(size_t count, unsigned int threadCount);
+
 MATERIALX_NAMESPACE_END
 
 #endif
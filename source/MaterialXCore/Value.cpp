@@ -7,6 +7,8 @@
 #include <MaterialXCore/Document.h>
 #include <MaterialXCore/Value.h>
 
+#include <cctype>
+#include <charconv>
 #include <iomanip>
 #include <sstream>
 #include <type_traits>
@@ -24,6 +26,105 @@ thread_local int _floatPrecision = 6;
 template <class T> inline constexpr bool is_std_vector_v = false;
 template <class T> inline constexpr bool is_std_vector_v<vector<T>> = true;
 
+template <class T> string numberToStream(T data)
+{
+    std::stringstream ss;
+    ss.imbue(std::locale::classic());
+
+    // Set float format and precision for the stream
+    ss.setf(std::ios_base::fmtflags(
+            (_floatFormat == Value::FloatFormatFixed ? std::ios_base::fixed :
+            (_floatFormat == Value::FloatFormatScientific ? std::ios_base::scientific : 0))),
+        std::ios_base::floatfield);
+    ss.precision(_floatPrecision);
+
+    ss << data;
+    return ss.str();
+}
+
+template <class T> T numberFromStream(const string& value)
+{
+    T data;
+    std::stringstream ss(value);
+    ss.imbue(std::locale::classic());
+    if (!(ss >> data))
+    {
+        throw ExceptionTypeError("Type mismatch in generic fromValueString: " + value);
+    }
+    return data;
+}
+
+// Append the string representation of a number, formatted as a classic
+// locale stream would format it with the current float format and precision.
+template <class T> void appendNumberString(string& str, T data)
+{
+#if defined(__cpp_lib_to_chars)
+    char buffer[128];
+    std::to_chars_result result = { buffer, std::errc::invalid_argument };
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (_floatPrecision >= 0)
+        {
+            std::chars_format format = _floatFormat == Value::FloatFormatFixed ? std::chars_format::fixed :
+                                       _floatFormat == Value::FloatFormatScientific ? std::chars_format::scientific :
+                                       std::chars_format::general;
+            result = std::to_chars(buffer, buffer + sizeof(buffer), data, format, _floatPrecision);
+        }
+    }
+    else
+    {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), data);
+    }
+    if (result.ec == std::errc())
+    {
+        str.append(buffer, result.ptr);
+        return;
+    }
+#endif
+    str += numberToStream(data);
+}
+
+// Parse a number from the given range of characters, as a classic locale
+// stream would parse it.  Inputs that std::from_chars would interpret
+// differently, such as leading whitespace, infinities and out-of-range
+// values, are handed to a stream.
+template <class T> T parseNumber(const char* begin, const char* end)
+{
+#if defined(__cpp_lib_to_chars)
+    const char* digits = (begin != end && *begin == '-') ? begin + 1 : begin;
+    if (digits != end && (std::isdigit((unsigned char) *digits) || *digits == '.'))
+    {
+        T data;
+        std::from_chars_result result = std::from_chars(begin, end, data);
+        bool partialExponent = std::is_floating_point_v<T> && result.ptr != end &&
+                               (*result.ptr == 'e' || *result.ptr == 'E');
+        if (result.ec == std::errc() && !partialExponent)
+        {
+            return data;
+        }
+    }
+#endif
+    return numberFromStream<T>(string(begin, end));
+}
+
+// Call the given function with the character range of each token in the
+// given string, splitting at any of the given separators and skipping empty
+// tokens as splitString does.  Returns the number of tokens.
+template <class F> size_t forEachToken(const string& str, const string& sep, F func)
+{
+    size_t count = 0;
+    string::size_type lastPos = str.find_first_not_of(sep, 0);
+    while (lastPos != string::npos)
+    {
+        string::size_type pos = str.find_first_of(sep, lastPos);
+        const char* begin = str.data() + lastPos;
+        const char* end = str.data() + (pos == string::npos ? str.size() : pos);
+        func(begin, end, count++);
+        lastPos = str.find_first_not_of(sep, pos);
+    }
+    return count;
+}
+
 } // anonymous namespace
 
 //
@@ -51,7 +152,7 @@ template <class T> string toValueString(const T& data)
     {
         for (size_t i = 0; i < data.numElements(); i++)
         {
-            str += toValueString(data[i]);
+            appendNumberString(str, data[i]);
             if (i + 1 < data.numElements())
             {
                 str += ARRAY_PREFERRED_SEPARATOR;
@@ -64,7 +165,7 @@ template <class T> string toValueString(const T& data)
         {
             for (size_t j = 0; j < data.numColumns(); j++)
             {
-                str += toValueString(data[i][j]);
+                appendNumberString(str, data[i][j]);
                 if (i + 1 < data.numRows() ||
                     j + 1 < data.numColumns())
                 {
@@ -77,28 +178,28 @@ template <class T> string toValueString(const T& data)
     {
         for (size_t i = 0; i < data.size(); i++)
         {
-            str += toValueString<typename T::value_type>(data[i]);
+            if constexpr(std::is_same_v<typename T::value_type, string> ||
+                         std::is_same_v<typename T::value_type, bool>)
+            {
+                str += toValueString<typename T::value_type>(data[i]);
+            }
+            else
+            {
+                appendNumberString(str, data[i]);
+            }
             if (i + 1 < data.size())
             {
                 str += ARRAY_PREFERRED_SEPARATOR;
             }
         }
     }
+    else if constexpr(std::is_arithmetic_v<T>)
+    {
+        appendNumberString(str, data);
+    }
     else
     {
-        std::stringstream ss;
-        ss.imbue(std::locale::classic());
-
-        // Set float format and precision for the stream
-        const Value::FloatFormat fmt = Value::getFloatFormat();
-        ss.setf(std::ios_base::fmtflags(
-                (fmt == Value::FloatFormatFixed ? std::ios_base::fixed :
-                (fmt == Value::FloatFormatScientific ? std::ios_base::scientific : 0))),
-            std::ios_base::floatfield);
-        ss.precision(Value::getFloatPrecision());
-
-        ss << data;
-        str = ss.str();
+        str = numberToStream(data);
     }
     
     return str;
@@ -123,29 +224,30 @@ template <class T> T fromValueString(const string& value)
     }
     else if constexpr(std::is_base_of_v<VectorBase, T>)
     {
-        StringVec tokens = splitString(value, ARRAY_VALID_SEPARATORS);
-        if (tokens.size() != data.numElements())
+        size_t count = forEachToken(value, ARRAY_VALID_SEPARATORS, [&](const char* begin, const char* end, size_t i)
         {
-            throw ExceptionTypeError("Type mismatch in vector fromValueString: " + value);
-        }
-        for (size_t i = 0; i < data.numElements(); i++)
+            if (i < data.numElements())
+            {
+                data[i] = parseNumber<float>(begin, end);
+            }
+        });
+        if (count != data.numElements())
         {
-            data[i] = fromValueString<float>(tokens[i]);
+            throw ExceptionTypeError("Type mismatch in vector fromValueString: " + value);
         }
     }
     else if constexpr(std::is_base_of_v<MatrixBase, T>)
     {
-        StringVec tokens = splitString(value, ARRAY_VALID_SEPARATORS);
-        if (tokens.size() != data.numRows() * data.numColumns())
-        {
-            throw ExceptionTypeError("Type mismatch in matrix fromValueString: " + value);
-        }
-        for (size_t i = 0; i < data.numRows(); i++)
+        size_t count = forEachToken(value, ARRAY_VALID_SEPARATORS, [&](const char* begin, const char* end, size_t i)
         {
-            for (size_t j = 0; j < data.numColumns(); j++)
+            if (i < data.numRows() * data.numColumns())
             {
-                data[i][j] = fromValueString<float>(tokens[i * data.numRows() + j]);
+                data[i / data.numColumns()][i % data.numColumns()] = parseNumber<float>(begin, end);
             }
+        });
+        if (count != data.numRows() * data.numColumns())
+        {
+            throw ExceptionTypeError("Type mismatch in matrix fromValueString: " + value);
         }
     }
     else if constexpr(is_std_vector_v<T>)
@@ -153,20 +255,38 @@ template <class T> T fromValueString(const string& value)
         // This code path parses an array of arbitrary substrings, so we split the string
         // in a fashion that preserves substrings with internal spaces.
         const string COMMA_SEPARATOR = ",";
-        for (const string& token : splitString(value, COMMA_SEPARATOR))
+        if constexpr(std::is_same_v<typename T::value_type, string> ||
+                     std::is_same_v<typename T::value_type, bool>)
         {
-            typename T::value_type val = fromValueString<typename T::value_type>(trimSpaces(token));
-            data.push_back(val);
+            for (const string& token : splitString(value, COMMA_SEPARATOR))
+            {
+                typename T::value_type val = fromValueString<typename T::value_type>(trimSpaces(token));
+                data.push_back(val);
+            }
+        }
+        else
+        {
+            forEachToken(value, COMMA_SEPARATOR, [&](const char* begin, const char* end, size_t)
+            {
+                while (begin != end && *begin == ' ')
+                {
+                    begin++;
+                }
+                while (end != begin && *(end - 1) == ' ')
+                {
+                    end--;
+                }
+                data.push_back(parseNumber<typename T::value_type>(begin, end));
+            });
         }
     }
+    else if constexpr(std::is_arithmetic_v<T>)
+    {
+        data = parseNumber<T>(value.data(), value.data() + value.size());
+    }
     else
     {
-        std::stringstream ss(value);
-        ss.imbue(std::locale::classic());
-        if (!(ss >> data))
-        {
-            throw ExceptionTypeError("Type mismatch in generic fromValueString: " + value);
-        }
+        data = numberFromStream<T>(value);
     }
     
     return data;
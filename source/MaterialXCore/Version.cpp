@@ -71,56 +71,44 @@ void Document::upgradeVersion()
     int majorVersion = documentVersion.first;
     int minorVersion = documentVersion.second;
 
-    // Upgrade from v1.22 to v1.23
-    if (majorVersion == 1 && minorVersion == 22)
+    // Upgrade from v1.22 to v1.26, applying the element rules of each
+    // intermediate version in a single traversal.  These rules only read and
+    // write the state of the element being visited, so applying them in
+    // version order to each element in turn matches applying each version in
+    // a separate traversal.
+    if (majorVersion == 1 && minorVersion >= 22 && minorVersion <= 25)
     {
-        for (ElementPtr elem : traverseTree())
+        const int startMinorVersion = minorVersion;
+        if (startMinorVersion <= 23)
         {
-            if (elem->getAttribute(TypedElement::TYPE_ATTRIBUTE) == "vector")
+            for (ElementPtr child : getChildrenOfType<Element>("assign"))
             {
-                elem->setAttribute(TypedElement::TYPE_ATTRIBUTE, getTypeString<Vector3>());
+                changeChildCategory(child, "materialassign");
             }
         }
-        minorVersion = 23;
-    }
-
-    // Upgrade from v1.23 to v1.24
-    if (majorVersion == 1 && minorVersion == 23)
-    {
         for (ElementPtr elem : traverseTree())
         {
-            if (elem->getCategory() == "shader" && elem->hasAttribute("shadername"))
+            // Upgrade from v1.22 to v1.23
+            if (startMinorVersion <= 22 && elem->getAttribute(TypedElement::TYPE_ATTRIBUTE) == "vector")
             {
-                elem->setAttribute(NodeDef::NODE_ATTRIBUTE, elem->getAttribute("shadername"));
-                elem->removeAttribute("shadername");
+                elem->setAttribute(TypedElement::TYPE_ATTRIBUTE, getTypeString<Vector3>());
             }
-            for (ElementPtr child : getChildrenOfType<Element>("assign"))
+
+            // Upgrade from v1.23 to v1.24
+            if (startMinorVersion <= 23 && elem->getCategory() == "shader" && elem->hasAttribute("shadername"))
             {
-                elem->changeChildCategory(child, "materialassign");
+                elem->setAttribute(NodeDef::NODE_ATTRIBUTE, elem->getAttribute("shadername"));
+                elem->removeAttribute("shadername");
             }
-        }
-        minorVersion = 24;
-    }
 
-    // Upgrade from v1.24 to v1.25
-    if (majorVersion == 1 && minorVersion == 24)
-    {
-        for (ElementPtr elem : traverseTree())
-        {
-            if (elem->isA<Input>() && elem->hasAttribute("graphname"))
+            // Upgrade from v1.24 to v1.25
+            if (startMinorVersion <= 24 && elem->isA<Input>() && elem->hasAttribute("graphname"))
             {
                 elem->setAttribute("opgraph", elem->getAttribute("graphname"));
                 elem->removeAttribute("graphname");
             }
-        }
-        minorVersion = 25;
-    }
 
-    // Upgrade from v1.25 to v1.26
-    if (majorVersion == 1 && minorVersion == 25)
-    {
-        for (ElementPtr elem : traverseTree())
-        {
+            // Upgrade from v1.25 to v1.26
             if (elem->getCategory() == "constant")
             {
                 ElementPtr param = elem->getChild("color");
@@ -214,25 +202,32 @@ void Document::upgradeVersion()
             }
         }
 
-        // Move connections from nodedef inputs to bindinputs.
-        ElementVec materials = getChildrenOfType<Element>("material");
+        // Move connections from nodedef inputs to bindinputs, resolving the
+        // nodedef of each shaderref once, since adding bindinputs does not
+        // affect this resolution.
+        vector<std::pair<ElementPtr, NodeDefPtr>> shaderRefNodeDefs;
+        for (ElementPtr mat : getChildrenOfType<Element>("material"))
+        {
+            for (ElementPtr shaderRef : mat->getChildrenOfType<Element>("shaderref"))
+            {
+                shaderRefNodeDefs.emplace_back(shaderRef, getShaderNodeDef(shaderRef));
+            }
+        }
         for (NodeDefPtr nodeDef : getNodeDefs())
         {
             for (InputPtr input : nodeDef->getActiveInputs())
             {
                 if (input->hasAttribute("opgraph") && input->hasAttribute("graphoutput"))
                 {
-                    for (ElementPtr mat : materials)
+                    for (const auto& pair : shaderRefNodeDefs)
                     {
-                        for (ElementPtr shaderRef : mat->getChildrenOfType<Element>("shaderref"))
+                        ElementPtr shaderRef = pair.first;
+                        if (pair.second == nodeDef && !shaderRef->getChild(input->getName()))
                         {
-                            if (getShaderNodeDef(shaderRef) == nodeDef && !shaderRef->getChild(input->getName()))
-                            {
-                                ElementPtr bindInput = shaderRef->addChildOfCategory("bindinput", input->getName());
-                                bindInput->setAttribute(TypedElement::TYPE_ATTRIBUTE, input->getType());
-                                bindInput->setAttribute("nodegraph", input->getAttribute("opgraph"));
-                                bindInput->setAttribute("output", input->getAttribute("graphoutput"));
-                            }
+                            ElementPtr bindInput = shaderRef->addChildOfCategory("bindinput", input->getName());
+                            bindInput->setAttribute(TypedElement::TYPE_ATTRIBUTE, input->getType());
+                            bindInput->setAttribute("nodegraph", input->getAttribute("opgraph"));
+                            bindInput->setAttribute("output", input->getAttribute("graphoutput"));
                         }
                     }
                     input->removeAttribute("opgraph");
@@ -407,18 +402,21 @@ void Document::upgradeVersion()
         }
 
         // Remove legacy shader nodedefs.
+        ElementVec shaderRefs;
+        for (ElementPtr mat : getChildrenOfType<Element>("material"))
+        {
+            ElementVec matShaderRefs = mat->getChildrenOfType<Element>("shaderref");
+            shaderRefs.insert(shaderRefs.end(), matShaderRefs.begin(), matShaderRefs.end());
+        }
         for (NodeDefPtr nodeDef : getNodeDefs())
         {
             if (nodeDef->hasAttribute("shadertype"))
             {
-                for (ElementPtr mat : getChildrenOfType<Element>("material"))
+                for (ElementPtr shaderRef : shaderRefs)
                 {
-                    for (ElementPtr shaderRef : mat->getChildrenOfType<Element>("shaderref"))
+                    if (shaderRef->getAttribute(InterfaceElement::NODE_DEF_ATTRIBUTE) == nodeDef->getName())
                     {
-                        if (shaderRef->getAttribute(InterfaceElement::NODE_DEF_ATTRIBUTE) == nodeDef->getName())
-                        {
-                            shaderRef->removeAttribute(InterfaceElement::NODE_DEF_ATTRIBUTE);
-                        }
+                        shaderRef->removeAttribute(InterfaceElement::NODE_DEF_ATTRIBUTE);
                     }
                 }
                 removeNodeDef(nodeDef->getName());
@@ -433,6 +431,9 @@ void Document::upgradeVersion()
                 geomInfo->changeChildCategory(child, "geomprop");
             }
         }
+
+        // Update all nodes.
+        vector<NodePtr> unusedNodes;
         for (ElementPtr elem : traverseTree())
         {
             NodePtr node = elem->asA<Node>();
@@ -440,8 +441,10 @@ void Document::upgradeVersion()
             {
                 continue;
             }
+            const string& nodeCategory = node->getCategory();
 
-            if (node->getCategory() == "geomattrvalue")
+            // Convert geometric attribute values to geometric property values.
+            if (nodeCategory == "geomattrvalue")
             {
                 node->setCategory("geompropvalue");
                 if (node->hasAttribute("attrname"))
@@ -450,20 +453,9 @@ void Document::upgradeVersion()
                     node->removeAttribute("attrname");
                 }
             }
-        }
-
-        vector<NodePtr> unusedNodes;
-        for (ElementPtr elem : traverseTree())
-        {
-            NodePtr node = elem->asA<Node>();
-            if (!node)
-            {
-                continue;
-            }
-            const string& nodeCategory = node->getCategory();
 
             // Change category from "invert to "invertmatrix" for matrix invert nodes
-            if (nodeCategory == "invert" &&
+            else if (nodeCategory == "invert" &&
                 (node->getType() == getTypeString<Matrix33>() || node->getType() == getTypeString<Matrix44>()))
             {
                 node->setCategory("invertmatrix");
@@ -574,6 +566,7 @@ void Document::upgradeVersion()
     }
 
     // Upgrade from 1.37 to 1.38
+    bool convertParameters = false;
     if (majorVersion == 1 && minorVersion == 37)
     {
         // Convert color2 types to vector2
@@ -954,22 +947,9 @@ void Document::upgradeVersion()
             }
         }
 
-        // Convert parameters to inputs, applying uniform markings to converted inputs
-        // of nodedefs.
-        for (ElementPtr elem : traverseTree())
-        {
-            if (elem->isA<InterfaceElement>())
-            {
-                for (ElementPtr param : elem->getChildrenOfType<Element>("parameter"))
-                {
-                    InputPtr input = elem->changeChildCategory(param, "input")->asA<Input>();
-                    if (elem->isA<NodeDef>())
-                    {
-                        input->setIsUniform(true);
-                    }
-                }
-            }
-        }
+        // Parameters are converted to inputs in the first traversal of the
+        // following version.
+        convertParameters = true;
 
         minorVersion = 38;
     }
@@ -1010,6 +990,22 @@ void Document::upgradeVersion()
         // to modern nodes in a second pass.
         for (ElementPtr elem : traverseTree())
         {
+            // Convert parameters to inputs, applying uniform markings to converted
+            // inputs of nodedefs.  Parameters are converted before their parent's
+            // children are visited, so channels attributes on converted inputs are
+            // handled below.
+            if (convertParameters && elem->isA<InterfaceElement>())
+            {
+                for (ElementPtr param : elem->getChildrenOfType<Element>("parameter"))
+                {
+                    InputPtr input = elem->changeChildCategory(param, "input")->asA<Input>();
+                    if (elem->isA<NodeDef>())
+                    {
+                        input->setIsUniform(true);
+                    }
+                }
+            }
+
             PortElementPtr port = elem->asA<PortElement>();
             if (!port)
             {
@@ -0,0 +1,285 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <MaterialXFormat/BinaryIo.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+MATERIALX_NAMESPACE_BEGIN
+
+const string MTLX_BINARY_EXTENSION = "mtlxbin";
+
+namespace
+{
+
+// The binary format consists of a header, a table of unique strings, and the
+// element tree in depth-first order.  Elements refer to strings by index, and
+// all integers are stored as 32-bit little-endian values.
+//
+// Each element is stored as its source URI, its attribute count followed by
+// attribute name and value pairs, and its child count followed by the
+// category, name, and contents of each child.
+const char BINARY_MAGIC[8] = { 'M', 'T', 'L', 'X', 'B', 'I', 'N', '\0' };
+const uint32_t BINARY_FORMAT_VERSION = 1;
+
+class BinaryWriter
+{
+  public:
+    void writeDocument(DocumentPtr doc, std::ostream& stream)
+    {
+        writeElement(doc, 1);
+
+        std::ostringstream header;
+        header.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        writeUInt(header, BINARY_FORMAT_VERSION);
+        writeUInt(header, (uint32_t) _strings.size());
+        for (const string* str : _strings)
+        {
+            writeUInt(header, (uint32_t) str->size());
+            header.write(str->data(), (std::streamsize) str->size());
+        }
+
+        stream << header.str();
+        stream << _elements.str();
+    }
+
+  private:
+    void writeElement(ConstElementPtr elem, int depth)
+    {
+        if (depth > MAX_XML_TREE_DEPTH)
+        {
+            throw Exception("Maximum tree depth exceeded.");
+        }
+
+        writeString(elem->getSourceUri());
+        writeUInt(_elements, (uint32_t) elem->getAttributeCount());
+        for (size_t i = 0; i < elem->getAttributeCount(); i++)
+        {
+            writeString(elem->getAttributeName(i));
+            writeString(elem->getAttributeValue(i));
+        }
+
+        const vector<ElementPtr>& children = elem->getChildren();
+        writeUInt(_elements, (uint32_t) children.size());
+        for (const ElementPtr& child : children)
+        {
+            writeString(child->getCategory());
+            writeString(child->getName());
+            writeElement(child, depth + 1);
+        }
+    }
+
+    void writeString(const string& str)
+    {
+        auto it = _stringIndices.find(str);
+        if (it == _stringIndices.end())
+        {
+            it = _stringIndices.emplace(str, (uint32_t) _strings.size()).first;
+            _strings.push_back(&it->first);
+        }
+        writeUInt(_elements, it->second);
+    }
+
+    static void writeUInt(std::ostream& stream, uint32_t value)
+    {
+        const char bytes[4] = { (char) (value & 0xFF), (char) ((value >> 8) & 0xFF),
+                                (char) ((value >> 16) & 0xFF), (char) ((value >> 24) & 0xFF) };
+        stream.write(bytes, sizeof(bytes));
+    }
+
+  private:
+    std::unordered_map<string, uint32_t> _stringIndices;
+    vector<const string*> _strings;
+    std::ostringstream _elements;
+};
+
+class BinaryReader
+{
+  public:
+    BinaryReader(const char* buffer, size_t size) :
+        _data(buffer),
+        _end(buffer + size)
+    {
+    }
+
+    void readDocument(DocumentPtr doc)
+    {
+        if ((size_t) (_end - _data) < sizeof(BINARY_MAGIC) || std::memcmp(_data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0)
+        {
+            throw ExceptionParseError("Invalid binary document header.");
+        }
+        _data += sizeof(BINARY_MAGIC);
+        if (readUInt() != BINARY_FORMAT_VERSION)
+        {
+            throw ExceptionParseError("Unsupported binary document version.");
+        }
+
+        uint32_t stringCount = readUInt();
+        _strings.reserve(std::min((size_t) stringCount, (size_t) (_end - _data) / 4));
+        for (uint32_t i = 0; i < stringCount; i++)
+        {
+            uint32_t length = readUInt();
+            require(length);
+            _strings.emplace_back(_data, length);
+            _data += length;
+        }
+
+        readElement(doc, 1);
+        if (_data != _end)
+        {
+            throw ExceptionParseError("Unexpected data at the end of binary document.");
+        }
+
+        // Upgrade documents that were written by earlier versions.
+        doc->upgradeVersion();
+    }
+
+  private:
+    void readElement(ElementPtr elem, int depth)
+    {
+        const string& sourceUri = readString();
+        if (!sourceUri.empty())
+        {
+            elem->setSourceUri(sourceUri);
+        }
+
+        uint32_t attrCount = readUInt();
+        for (uint32_t i = 0; i < attrCount; i++)
+        {
+            const string& attrName = readString();
+            const string& attrValue = readString();
+            elem->setAttribute(attrName, attrValue);
+        }
+
+        uint32_t childCount = readUInt();
+        for (uint32_t i = 0; i < childCount; i++)
+        {
+            const string& category = readString();
+            const string& name = readString();
+            if (depth >= MAX_XML_TREE_DEPTH)
+            {
+                throw ExceptionParseError("Maximum tree depth exceeded.");
+            }
+
+            // Skip duplicate elements, as in XML reading.
+            if (elem->getChild(name))
+            {
+                skipElement(depth + 1);
+                continue;
+            }
+
+            ElementPtr child = elem->addChildOfCategory(category, name);
+            readElement(child, depth + 1);
+        }
+    }
+
+    void skipElement(int depth)
+    {
+        readString();
+        uint32_t attrCount = readUInt();
+        for (uint32_t i = 0; i < attrCount; i++)
+        {
+            readString();
+            readString();
+        }
+        uint32_t childCount = readUInt();
+        for (uint32_t i = 0; i < childCount; i++)
+        {
+            readString();
+            readString();
+            if (depth >= MAX_XML_TREE_DEPTH)
+            {
+                throw ExceptionParseError("Maximum tree depth exceeded.");
+            }
+            skipElement(depth + 1);
+        }
+    }
+
+    const string& readString()
+    {
+        uint32_t index = readUInt();
+        if (index >= _strings.size())
+        {
+            throw ExceptionParseError("Invalid string index in binary document.");
+        }
+        return _strings[index];
+    }
+
+    uint32_t readUInt()
+    {
+        require(4);
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(_data);
+        _data += 4;
+        return (uint32_t) bytes[0] | ((uint32_t) bytes[1] << 8) |
+               ((uint32_t) bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+    }
+
+    void require(size_t size) const
+    {
+        if ((size_t) (_end - _data) < size)
+        {
+            throw ExceptionParseError("Unexpected end of binary document.");
+        }
+    }
+
+  private:
+    const char* _data;
+    const char* _end;
+    StringVec _strings;
+};
+
+} // anonymous namespace
+
+//
+// Reading
+//
+
+void readFromBinaryBuffer(DocumentPtr doc, const char* buffer, size_t size)
+{
+    BinaryReader reader(buffer, size);
+    reader.readDocument(doc);
+}
+
+void readFromBinaryFile(DocumentPtr doc, FilePath filename, FileSearchPath searchPath)
+{
+    searchPath.append(getEnvironmentPath());
+    filename = searchPath.find(filename);
+
+    MappedFilePtr file = MappedFile::create(filename);
+    if (!file)
+    {
+        throw ExceptionFileMissing("Failed to open file for reading: " + filename.asString());
+    }
+    readFromBinaryBuffer(doc, file->getData(), file->getSize());
+}
+
+//
+// Writing
+//
+
+void writeToBinaryStream(DocumentPtr doc, std::ostream& stream)
+{
+    BinaryWriter writer;
+    writer.writeDocument(doc, stream);
+}
+
+void writeToBinaryFile(DocumentPtr doc, const FilePath& filename)
+{
+    std::ofstream ofs(filename.asString(), std::ios::out | std::ios::binary);
+    writeToBinaryStream(doc, ofs);
+}
+
+string writeToBinaryString(DocumentPtr doc)
+{
+    std::ostringstream stream;
+    writeToBinaryStream(doc, stream);
+    return stream.str();
+}
+
+MATERIALX_NAMESPACE_END
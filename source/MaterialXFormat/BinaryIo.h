@@ -0,0 +1,67 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef MATERIALX_BINARYIO_H
+#define MATERIALX_BINARYIO_H
+
+/// @file
+/// Support for a compact binary serialization of documents
+
+#include <MaterialXFormat/Export.h>
+#include <MaterialXFormat/XmlIo.h>
+
+MATERIALX_NAMESPACE_BEGIN
+
+extern MX_FORMAT_API const string MTLX_BINARY_EXTENSION;
+
+/// @name Read Functions
+/// @{
+
+/// Read a Document from the given buffer of binary data, as written by
+/// one of the binary write functions.
+/// @param doc The Document into which data is read.
+/// @param buffer The buffer from which data is read.
+/// @param size The size of the buffer in bytes.
+/// @throws ExceptionParseError if the data cannot be parsed.
+MX_FORMAT_API void readFromBinaryBuffer(DocumentPtr doc, const char* buffer, size_t size);
+
+/// Read a Document from the given binary file.  Where supported by the
+/// platform, the file is mapped into memory rather than copied.
+/// @param doc The Document into which data is read.
+/// @param filename The filename from which data is read.  This argument can
+///    be supplied either as a FilePath or a standard string.
+/// @param searchPath An optional sequence of file paths that will be applied
+///    in order when searching for the given file.
+/// @throws ExceptionParseError if the data cannot be parsed.
+/// @throws ExceptionFileMissing if the file cannot be opened.
+MX_FORMAT_API void readFromBinaryFile(DocumentPtr doc, FilePath filename, FileSearchPath searchPath = FileSearchPath());
+
+/// @}
+/// @name Write Functions
+/// @{
+
+/// Write a Document in binary form to the given output stream.  All elements
+/// are written with their attributes and source URIs, so that libraries may be
+/// stored as a single snapshot and restored without parsing XML.
+/// @param doc The Document to be written.
+/// @param stream The output stream to which data is written.
+MX_FORMAT_API void writeToBinaryStream(DocumentPtr doc, std::ostream& stream);
+
+/// Write a Document in binary form to the given filename.
+/// @param doc The Document to be written.
+/// @param filename The filename to which data is written.  This argument can
+///    be supplied either as a FilePath or a standard string.
+MX_FORMAT_API void writeToBinaryFile(DocumentPtr doc, const FilePath& filename);
+
+/// Write a Document in binary form to a new string, returned by value.
+/// @param doc The Document to be written.
+/// @return The output string, returned by value
+MX_FORMAT_API string writeToBinaryString(DocumentPtr doc);
+
+/// @}
+
+MATERIALX_NAMESPACE_END
+
+#endif
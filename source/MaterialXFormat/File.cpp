@@ -17,6 +17,10 @@
     #include <unistd.h>
     #include <sys/stat.h>
     #include <dirent.h>
+    #include <fcntl.h>
+    #if !defined(__EMSCRIPTEN__)
+        #include <sys/mman.h>
+    #endif
 #endif
 
 #if defined(__linux__)
@@ -31,6 +35,8 @@
 #include <cctype>
 #include <cerrno>
 #include <cstring>
+#include <fstream>
+#include <iterator>
 
 MATERIALX_NAMESPACE_BEGIN
 
@@ -179,6 +185,41 @@ bool FilePath::isDirectory() const
 #endif
 }
 
+int64_t FilePath::getModificationTime() const
+{
+#if defined(_WIN32)
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(asString().c_str(), GetFileExInfoStandard, &data))
+        return 0;
+    return ((int64_t) data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+#else
+    struct stat sb;
+    if (stat(asString().c_str(), &sb))
+        return 0;
+#if defined(__APPLE__)
+    const struct timespec& mtime = sb.st_mtimespec;
+#else
+    const struct timespec& mtime = sb.st_mtim;
+#endif
+    return (int64_t) mtime.tv_sec * 1000000000 + (int64_t) mtime.tv_nsec;
+#endif
+}
+
+uint64_t FilePath::getFileSize() const
+{
+#if defined(_WIN32)
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(asString().c_str(), GetFileExInfoStandard, &data))
+        return 0;
+    return ((uint64_t) data.nFileSizeHigh << 32) | data.nFileSizeLow;
+#else
+    struct stat sb;
+    if (stat(asString().c_str(), &sb))
+        return 0;
+    return (uint64_t) sb.st_size;
+#endif
+}
+
 FilePathVec FilePath::getFilesInDirectory(const string& extension) const
 {
     FilePathVec files;
@@ -371,6 +412,115 @@ FilePath FilePath::getModulePath()
 #endif
 }
 
+//
+// MappedFile methods
+//
+
+MappedFile::MappedFile() :
+    _data(nullptr),
+    _size(0),
+    _mapping(nullptr)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFilePtr MappedFile::create(const FilePath& filePath)
+{
+    MappedFilePtr file = std::make_shared<MappedFile>();
+    if (!file->open(filePath))
+    {
+        return nullptr;
+    }
+    return file;
+}
+
+bool MappedFile::open(const FilePath& filePath)
+{
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileA(filePath.asString().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0)
+        {
+            HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mappingHandle)
+            {
+                _data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+                if (_data)
+                {
+                    _size = (size_t) fileSize.QuadPart;
+                    _mapping = mappingHandle;
+                }
+                else
+                {
+                    CloseHandle(mappingHandle);
+                }
+            }
+        }
+        CloseHandle(fileHandle);
+        if (_mapping)
+        {
+            return true;
+        }
+    }
+#elif !defined(__EMSCRIPTEN__)
+    int fd = ::open(filePath.asString().c_str(), O_RDONLY);
+    if (fd != -1)
+    {
+        struct stat sb;
+        if (fstat(fd, &sb) == 0 && sb.st_size > 0)
+        {
+            void* mapping = mmap(nullptr, (size_t) sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+            {
+                _data = static_cast<const char*>(mapping);
+                _size = (size_t) sb.st_size;
+                _mapping = mapping;
+            }
+        }
+        ::close(fd);
+        if (_mapping)
+        {
+            return true;
+        }
+    }
+#endif
+
+    // Fall back to reading the file into memory.
+    std::ifstream stream(filePath.asString(), std::ios::in | std::ios::binary);
+    if (!stream)
+    {
+        return false;
+    }
+    _buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    _data = _buffer.data();
+    _size = _buffer.size();
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_mapping)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(_data);
+        CloseHandle(static_cast<HANDLE>(_mapping));
+#elif !defined(__EMSCRIPTEN__)
+        munmap(_mapping, _size);
+#endif
+        _mapping = nullptr;
+    }
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0;
+}
+
 FileSearchPath getEnvironmentPath(const string& sep)
 {
     string searchPathEnv = getEnviron(MATERIALX_SEARCH_PATH_ENV_VAR);
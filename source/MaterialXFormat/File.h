@@ -16,8 +16,12 @@
 MATERIALX_NAMESPACE_BEGIN
 
 class FilePath;
+class MappedFile;
 using FilePathVec = vector<FilePath>;
 
+/// A shared pointer to a MappedFile
+using MappedFilePtr = shared_ptr<MappedFile>;
+
 extern MX_FORMAT_API const string PATH_LIST_SEPARATOR;
 extern MX_FORMAT_API const string MATERIALX_SEARCH_PATH_ENV_VAR;
 
@@ -187,6 +191,16 @@ class MX_FORMAT_API FilePath
     /// Return true if the given path is a directory on the file system.
     bool isDirectory() const;
 
+    /// Return a timestamp for the last modification of the file at the given
+    /// path, at the finest resolution that the file system provides, suitable
+    /// for detecting changes to the file between calls.  If the path does not
+    /// exist on the file system, then zero is returned.
+    int64_t getModificationTime() const;
+
+    /// Return the size in bytes of the file at the given path.  If the path
+    /// does not exist on the file system, then zero is returned.
+    uint64_t getFileSize() const;
+
     /// Return a vector of all files in the given directory with the given extension.
     /// If extension is empty all files are returned.
     FilePathVec getFilesInDirectory(const string& extension = EMPTY_STRING) const;
@@ -346,6 +360,44 @@ class MX_FORMAT_API FileSearchPath
     FilePathVec _paths;
 };
 
+/// @class MappedFile
+/// A read-only view of the contents of a file.  Where supported by the
+/// platform, the file is mapped into memory rather than copied.
+class MX_FORMAT_API MappedFile
+{
+  public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Open a view of the given file, returning a shared pointer to the
+    /// new view, or an empty shared pointer if the file could not be opened.
+    static MappedFilePtr create(const FilePath& filePath);
+
+    /// Return a pointer to the contents of the file.
+    const char* getData() const
+    {
+        return _data;
+    }
+
+    /// Return the size of the file in bytes.
+    size_t getSize() const
+    {
+        return _size;
+    }
+
+  private:
+    bool open(const FilePath& filePath);
+    void close();
+
+  private:
+    const char* _data;
+    size_t _size;
+    void* _mapping;
+    vector<char> _buffer;
+};
+
 /// Return a FileSearchPath object from search path environment variable.
 MX_FORMAT_API FileSearchPath getEnvironmentPath(const string& sep = PATH_LIST_SEPARATOR);
 
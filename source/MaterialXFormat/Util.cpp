@@ -5,6 +5,7 @@
 
 #include <MaterialXFormat/Util.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -88,57 +89,74 @@ StringSet loadLibraries(const FilePathVec& libraryFolders,
                         const FileSearchPath& searchPath,
                         DocumentPtr doc,
                         const StringSet& excludeFiles,
-                        const XmlReadOptions* readOptions)
+                        const XmlReadOptions* readOptions,
+                        unsigned int threadCount)
 {
     // Append environment path to the specified search path.
     FileSearchPath librarySearchPath = searchPath;
     librarySearchPath.append(getEnvironmentPath());
 
+    // Gather the library files to load, in load order.
     StringSet loadedLibraries;
-    if (libraryFolders.empty())
+    FilePathVec libraryFiles;
+    auto gatherLibraryFiles = [&](const FilePath& libraryPath)
     {
-        // No libraries specified so scan in all search paths
-        for (const FilePath& libraryPath : librarySearchPath)
+        for (const FilePath& path : libraryPath.getSubDirectories())
         {
-            for (const FilePath& path : libraryPath.getSubDirectories())
+            for (const FilePath& filename : path.getFilesInDirectory(MTLX_EXTENSION))
             {
-                for (const FilePath& filename : path.getFilesInDirectory(MTLX_EXTENSION))
+                if (!excludeFiles.count(filename))
                 {
-                    if (!excludeFiles.count(filename))
+                    const FilePath& file = path / filename;
+                    if (loadedLibraries.count(file) == 0)
                     {
-                        const FilePath& file = path / filename;
-                        if (loadedLibraries.count(file) == 0)
-                        {
-                            loadLibrary(file, doc, searchPath, readOptions);
-                            loadedLibraries.insert(file.asString());
-                        }
+                        libraryFiles.push_back(file);
+                        loadedLibraries.insert(file.asString());
                     }
                 }
             }
         }
+    };
+    if (libraryFolders.empty())
+    {
+        // No libraries specified so scan in all search paths
+        for (const FilePath& libraryPath : librarySearchPath)
+        {
+            gatherLibraryFiles(libraryPath);
+        }
     }
     else
     {
         // Look for specific library folders in the search paths
         for (const FilePath& libraryName : libraryFolders)
         {
-            FilePath libraryPath = librarySearchPath.find(libraryName);
-            for (const FilePath& path : libraryPath.getSubDirectories())
-            {
-                for (const FilePath& filename : path.getFilesInDirectory(MTLX_EXTENSION))
-                {
-                    if (!excludeFiles.count(filename))
-                    {
-                        const FilePath& file = path / filename;
-                        if (loadedLibraries.count(file) == 0)
-                        {
-                            loadLibrary(file, doc, searchPath, readOptions);
-                            loadedLibraries.insert(file.asString());
-                        }
-                    }
-                }
-            }
+            gatherLibraryFiles(librarySearchPath.find(libraryName));
+        }
+    }
+
+    if (getParallelWorkerCount(libraryFiles.size(), threadCount) <= 1)
+    {
+        for (const FilePath& file : libraryFiles)
+        {
+            loadLibrary(file, doc, searchPath, readOptions);
         }
+        return loadedLibraries;
+    }
+
+    // Parse library files into separate documents in parallel.
+    vector<DocumentPtr> libDocs(libraryFiles.size());
+    parallelFor(libraryFiles.size(), threadCount, [&](size_t i, unsigned int)
+    {
+        DocumentPtr libDoc = createDocument();
+        readFromXmlFile(libDoc, libraryFiles[i], searchPath, readOptions);
+        libDocs[i] = libDoc;
+    });
+
+    // Import the parsed documents in load order, so that the results
+    // match those of serial loading.
+    for (const DocumentPtr& libDoc : libDocs)
+    {
+        doc->importLibrary(libDoc);
     }
     return loadedLibraries;
 }
@@ -44,11 +44,23 @@ MX_FORMAT_API void loadLibrary(const FilePath& file,
 
 /// Load all MaterialX files within the given library folders into a document,
 /// using the given search path to locate the folders on the file system.
+/// @param libraryFolders The library folders to load.  If empty, then all
+///    folders within the search path are loaded.
+/// @param searchPath The search path used to locate library folders.
+/// @param doc The document into which libraries are imported.
+/// @param excludeFiles An optional set of filenames to exclude.
+/// @param readOptions An optional pointer to an XmlReadOptions object.
+/// @param threadCount The number of threads used to parse library files.
+///    Files are parsed concurrently and then imported in a fixed order, with
+///    results identical to serial loading.  A value of zero selects the
+///    number of hardware threads.  Defaults to one.
+/// @return The set of library files that were loaded.
 MX_FORMAT_API StringSet loadLibraries(const FilePathVec& libraryFolders,
                                       const FileSearchPath& searchPath,
                                       DocumentPtr doc,
                                       const StringSet& excludeFiles = StringSet(),
-                                      const XmlReadOptions* readOptions = nullptr);
+                                      const XmlReadOptions* readOptions = nullptr,
+                                      unsigned int threadCount = 1);
 
 /// Flatten all filenames in the given document, applying string resolvers at the
 /// scope of each element and removing all fileprefix attributes.
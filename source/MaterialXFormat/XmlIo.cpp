@@ -12,6 +12,8 @@
 #include <cstring>
 #include <fstream>
 #include <sstream>
+#include <string_view>
+#include <unordered_map>
 
 using namespace pugi;
 
@@ -49,10 +51,10 @@ void documentToXml(DocumentPtr doc, xml_node& xmlRoot, const XmlWriteOptions* wr
         {
             xmlNode.append_attribute(Element::NAME_ATTRIBUTE.c_str()) = elem->getName().c_str();
         }
-        for (const string& attrName : elem->getAttributeNames())
+        for (size_t i = 0; i < elem->getAttributeCount(); i++)
         {
-            xml_attribute xmlAttr = xmlNode.append_attribute(attrName.c_str());
-            xmlAttr.set_value(elem->getAttribute(attrName).c_str());
+            xml_attribute xmlAttr = xmlNode.append_attribute(elem->getAttributeName(i).c_str());
+            xmlAttr.set_value(elem->getAttributeValue(i).c_str());
         }
 
         // Create child elements and recurse.
@@ -112,14 +114,56 @@ void documentToXml(DocumentPtr doc, xml_node& xmlRoot, const XmlWriteOptions* wr
     }
 }
 
-void elementFromXml(const xml_node& xmlNode, ElementPtr elem, const XmlReadOptions* readOptions, int depth = 1)
+// Storage for the strings passed from the XML tree into elements during a
+// single read.  Categories and attribute names are shared across all elements
+// with the same spelling, while names and values are assigned into reusable
+// buffers, so that no temporary strings are allocated per attribute.
+class XmlReadState
+{
+  public:
+    // Return a shared string with the given contents, which must remain
+    // valid for the lifetime of this object.
+    const string& intern(const char* str)
+    {
+        std::string_view view(str);
+        auto it = _pool.find(view);
+        if (it == _pool.end())
+        {
+            it = _pool.emplace(view, string(view)).first;
+        }
+        return it->second;
+    }
+
+    // Return a reusable string holding the given element name, which remains
+    // valid until the next call to this method.
+    const string& name(const char* str)
+    {
+        _name.assign(str);
+        return _name;
+    }
+
+    // Return a reusable string holding the given attribute value, which
+    // remains valid until the next call to this method.
+    const string& value(const char* str)
+    {
+        _value.assign(str);
+        return _value;
+    }
+
+  private:
+    std::unordered_map<std::string_view, string> _pool;
+    string _name;
+    string _value;
+};
+
+void elementFromXml(const xml_node& xmlNode, ElementPtr elem, const XmlReadOptions* readOptions, XmlReadState& state, int depth = 1)
 {
     // Store attributes in element.
     for (const xml_attribute& xmlAttr : xmlNode.attributes())
     {
         if (xmlAttr.name() != Element::NAME_ATTRIBUTE)
         {
-            elem->setAttribute(xmlAttr.name(), xmlAttr.value());
+            elem->setAttribute(state.intern(xmlAttr.name()), state.value(xmlAttr.value()));
         }
     }
 
@@ -127,14 +171,14 @@ void elementFromXml(const xml_node& xmlNode, ElementPtr elem, const XmlReadOptio
     for (const xml_node& xmlChild : xmlNode.children())
     {
         // Get child category.
-        string category = xmlChild.name();
-        if (category == XINCLUDE_TAG)
+        if (xmlChild.name() == XINCLUDE_TAG)
         {
             continue;
         }
+        const string& category = state.intern(xmlChild.name());
 
         // Get child name and skip duplicates.
-        string name = xmlChild.attribute(Element::NAME_ATTRIBUTE.c_str()).value();
+        const string& name = state.name(xmlChild.attribute(Element::NAME_ATTRIBUTE.c_str()).value());
         ConstElementPtr previous = elem->getChild(name);
         if (previous)
         {
@@ -149,7 +193,7 @@ void elementFromXml(const xml_node& xmlNode, ElementPtr elem, const XmlReadOptio
 
         // Create the child element.
         ElementPtr child = elem->addChildOfCategory(category, name);
-        elementFromXml(xmlChild, child, readOptions, depth + 1);
+        elementFromXml(xmlChild, child, readOptions, state, depth + 1);
 
         // Handle the interpretation of XML comments and newlines.
         if (readOptions && category.empty())
@@ -208,8 +252,11 @@ void documentFromXml(DocumentPtr doc, const xml_document& xmlDoc, const FileSear
         }
     }
 
-    // Build the element tree.
-    elementFromXml(xmlRoot, doc, readOptions);
+    // Build the element tree.  The document cache is rebuilt on demand
+    // after this bulk edit, rather than updated for each new element.
+    doc->invalidateCache();
+    XmlReadState state;
+    elementFromXml(xmlRoot, doc, readOptions, state);
 
     // Upgrade version if requested.
     if (!readOptions || readOptions->upgradeVersion)
@@ -474,11 +474,11 @@ void HlslShaderGenerator::emitPixelStage(const ShaderGraph& graph, GenContext& c
     // depending on the vertical flip flag.
     if (context.getOptions().fileTextureVerticalFlip)
     {
-        _tokenSubstitutions[ShaderGenerator::T_FILE_TRANSFORM_UV] = "mx_transform_uv_vflip.hlsl";
+        setTokenSubstitution(ShaderGenerator::T_FILE_TRANSFORM_UV, "mx_transform_uv_vflip.hlsl");
     }
     else
     {
-        _tokenSubstitutions[ShaderGenerator::T_FILE_TRANSFORM_UV] = "mx_transform_uv.hlsl";
+        setTokenSubstitution(ShaderGenerator::T_FILE_TRANSFORM_UV, "mx_transform_uv.hlsl");
     }
 
     emitLightFunctionDefinitions(graph, context, stage);
@@ -13,7 +13,8 @@ MATERIALX_NAMESPACE_BEGIN
 //
 
 GenContext::GenContext(ShaderGeneratorPtr sg) :
-    _sg(sg)
+    _sg(sg),
+    _sourceCache(SourceCache::create())
 {
     if (!_sg)
     {
@@ -15,6 +15,7 @@
 #include <MaterialXGenShader/GenUserData.h>
 #include <MaterialXGenShader/ShaderNode.h>
 #include <MaterialXGenShader/ShaderGenerator.h>
+#include <MaterialXGenShader/SourceCache.h>
 
 #include <MaterialXFormat/File.h>
 
@@ -82,6 +83,20 @@ class MX_GENSHADER_API GenContext
         return searchPath.find(filename).getNormalized();
     }
 
+    /// Set the cache of source code files used by this context.  A single
+    /// cache may be shared between contexts to avoid reading the same
+    /// source files from disk for each generated shader.
+    void setSourceCache(SourceCachePtr cache)
+    {
+        _sourceCache = cache;
+    }
+
+    /// Return the cache of source code files used by this context.
+    SourceCachePtr getSourceCache() const
+    {
+        return _sourceCache;
+    }
+
     /// Add reserved words that should not be used as
     /// identifiers during code generation.
     void addReservedWords(const StringSet& names)
@@ -210,6 +225,7 @@ class MX_GENSHADER_API GenContext
     ShaderGeneratorPtr _sg;
     GenOptions _options;
     FileSearchPath _sourceCodeSearchPath;
+    SourceCachePtr _sourceCache;
     StringSet _reservedWords;
 
     std::unordered_map<string, ShaderNodeImplPtr> _nodeImpls;
@@ -82,6 +82,9 @@ class MX_GENSHADER_API GenOptions
         libraryPrefix("libraries"),
         emitColorTransforms(true),
         elideConstantNodes(true),
+        foldConstantNodes(false),
+        mergeDuplicateNodes(false),
+        specializeUniforms(false),
         hwTransparency(false),
         hwSpecularEnvironmentMethod(SPECULAR_ENVIRONMENT_FIS),
         hwDirectionalAlbedoMethod(DIRECTIONAL_ALBEDO_ANALYTIC),
@@ -141,6 +144,32 @@ class MX_GENSHADER_API GenOptions
     /// Enable eliding constant nodes. Defaults to true.
     bool elideConstantNodes;
 
+    /// Enable folding of standard library math nodes whose inputs are
+    /// all constant values that are not published as shader uniforms,
+    /// replacing each such node with its result at generation time.
+    /// Conditional nodes with constant operands are likewise replaced by
+    /// the branch they select.  Defaults to false.
+    bool foldConstantNodes;
+
+    /// Enable merging of nodes that share an implementation, upstream
+    /// connections and input values, so that duplicated subgraphs are
+    /// emitted only once.  Inputs that are published as shader uniforms
+    /// are never merged.  Defaults to false.
+    bool mergeDuplicateNodes;
+
+    /// Enable specialization of generated shaders to the current values of
+    /// their public uniforms, baking each value into the shader graph as a
+    /// constant before the graph is optimized.  Texture and geometric
+    /// property inputs are never specialized, and the uniforms that were
+    /// specialized are listed by ShaderGraph::getSpecializedUniforms.
+    /// Defaults to false.
+    bool specializeUniforms;
+
+    /// If non-empty, restricts specialization to the uniforms with the
+    /// given element paths.  A uniform for an input that is not authored on
+    /// its node is identified by the path the input would have on the node.
+    StringSet specializedUniforms;
+
     /// Sets if transparency is needed or not for HW shaders.
     /// If a surface shader has potential of being transparent
     /// this must be set to true, otherwise no transparency
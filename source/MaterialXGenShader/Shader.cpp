@@ -52,6 +52,35 @@ const ShaderStage& Shader::getStage(const string& name) const
     return const_cast<Shader*>(this)->getStage(name);
 }
 
+ShaderPtr Shader::copy(const string& name) const
+{
+    ShaderPtr shader = std::make_shared<Shader>(name, _graph);
+    for (const ShaderStage* stage : _stages)
+    {
+        ShaderStagePtr stageCopy = std::make_shared<ShaderStage>(*stage);
+
+        // Replace shared variable blocks with copies of their variables.
+        for (VariableBlockMap* blocks : { &stageCopy->_uniforms, &stageCopy->_inputs, &stageCopy->_outputs })
+        {
+            for (auto& it : *blocks)
+            {
+                const VariableBlock& block = *it.second;
+                VariableBlockPtr blockCopy = std::make_shared<VariableBlock>(block.getName(), block.getInstance());
+                for (const ShaderPort* port : block.getVariableOrder())
+                {
+                    blockCopy->add(std::make_shared<ShaderPort>(*port));
+                }
+                it.second = blockCopy;
+            }
+        }
+
+        shader->_stagesMap[stage->getName()] = stageCopy;
+        shader->_stages.push_back(stageCopy.get());
+    }
+    shader->_attributeMap = _attributeMap;
+    return shader;
+}
+
 ShaderStagePtr Shader::createStage(const string& name, ConstSyntaxPtr syntax)
 {
     auto it = _stagesMap.find(name);
@@ -41,6 +41,14 @@ class MX_GENSHADER_API Shader
     /// Return the shader name
     const string& getName() const { return _name; }
 
+    /// Return a copy of this shader.  The copy shares the shader graph of
+    /// the original, but holds its own stages and variables, whose paths,
+    /// values and source code may be modified independently of the original.
+    ShaderPtr copy() const { return copy(_name); }
+
+    /// Return a copy of this shader with the given name.
+    ShaderPtr copy(const string& name) const;
+
     /// Return the number of shader stages for this shader.
     size_t numStages() const { return _stages.size(); }
 
@@ -474,6 +474,15 @@ void ShaderGenerator::registerShaderMetadata(const DocumentPtr& doc, GenContext&
     }
 }
 
+void ShaderGenerator::setTokenSubstitution(const string& token, const string& identifier) const
+{
+    auto it = _tokenSubstitutions.find(token);
+    if (it == _tokenSubstitutions.end() || it->second != identifier)
+    {
+        _tokenSubstitutions[token] = identifier;
+    }
+}
+
 void ShaderGenerator::replaceTokens(const StringMap& substitutions, ShaderStage& stage) const
 {
     // Replace tokens in source code
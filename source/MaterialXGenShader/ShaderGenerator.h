@@ -247,6 +247,11 @@ class MX_GENSHADER_API ShaderGenerator
     /// Replace tokens with identifiers according to the given substitutions map.
     void replaceTokens(const StringMap& substitutions, ShaderStage& stage) const;
 
+    /// Set the identifier substituted for the given token during generation.
+    /// The substitutions map is only modified when the identifier changes, so
+    /// that a generator may be shared by threads generating with equal options.
+    void setTokenSubstitution(const string& token, const string& identifier) const;
+
     /// Create shader variables (e.g. uniforms, inputs and outputs) for
     /// nodes that require input data from the application.
     void createVariables(ShaderGraphPtr graph, GenContext& context, Shader& shader) const;
@@ -9,18 +9,161 @@
 #include <MaterialXGenShader/GenContext.h>
 #include <MaterialXGenShader/Util.h>
 
+#include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <queue>
 
 MATERIALX_NAMESPACE_BEGIN
 
+namespace
+{
+
+// A component-wise evaluation of a math node, given one component of
+// each of its inputs in the order of the input names.
+using FoldFunction = float (*)(const float* args);
+
+float signOf(float x)
+{
+    return float(x > 0.0f) - float(x < 0.0f);
+}
+
+struct FoldOperation
+{
+    StringVec inputs;
+    FoldFunction function;
+};
+
+// Standard library math nodes that may be evaluated during generation,
+// matching the semantics of their shading language implementations.
+const std::unordered_map<string, FoldOperation> FOLD_OPERATIONS =
+{
+    { "add", { { "in1", "in2" }, [](const float* a) { return a[0] + a[1]; } } },
+    { "subtract", { { "in1", "in2" }, [](const float* a) { return a[0] - a[1]; } } },
+    { "multiply", { { "in1", "in2" }, [](const float* a) { return a[0] * a[1]; } } },
+    { "divide", { { "in1", "in2" }, [](const float* a) { return a[0] / a[1]; } } },
+    { "modulo", { { "in1", "in2" }, [](const float* a) { return a[0] - a[1] * std::floor(a[0] / a[1]); } } },
+    { "power", { { "in1", "in2" }, [](const float* a) { return std::pow(a[0], a[1]); } } },
+    { "safepower", { { "in1", "in2" }, [](const float* a) { return signOf(a[0]) * std::pow(std::abs(a[0]), a[1]); } } },
+    { "min", { { "in1", "in2" }, [](const float* a) { return std::min(a[0], a[1]); } } },
+    { "max", { { "in1", "in2" }, [](const float* a) { return std::max(a[0], a[1]); } } },
+    { "clamp", { { "in", "low", "high" }, [](const float* a) { return std::min(std::max(a[0], a[1]), a[2]); } } },
+    { "mix", { { "fg", "bg", "mix" }, [](const float* a) { return a[1] * (1.0f - a[2]) + a[0] * a[2]; } } },
+    { "invert", { { "in", "amount" }, [](const float* a) { return a[1] - a[0]; } } },
+    { "absval", { { "in" }, [](const float* a) { return std::abs(a[0]); } } },
+    { "sign", { { "in" }, [](const float* a) { return signOf(a[0]); } } },
+    { "floor", { { "in" }, [](const float* a) { return std::floor(a[0]); } } },
+    { "ceil", { { "in" }, [](const float* a) { return std::ceil(a[0]); } } },
+    { "round", { { "in" }, [](const float* a) { return std::round(a[0]); } } },
+    { "sqrt", { { "in" }, [](const float* a) { return std::sqrt(a[0]); } } },
+    { "exp", { { "in" }, [](const float* a) { return std::exp(a[0]); } } },
+    { "ln", { { "in" }, [](const float* a) { return std::log(a[0]); } } },
+    { "sin", { { "in" }, [](const float* a) { return std::sin(a[0]); } } },
+    { "cos", { { "in" }, [](const float* a) { return std::cos(a[0]); } } },
+};
+
+const size_t MAX_FOLD_INPUTS = 3;
+
+// Standard library conditional nodes, which select their in1 input when
+// the comparison of their value1 and value2 inputs holds, and in2 otherwise.
+using CompareFunction = bool (*)(double a, double b);
+
+const std::unordered_map<string, CompareFunction> FOLD_CONDITIONALS =
+{
+    { "ifgreater", [](double a, double b) { return a > b; } },
+    { "ifgreatereq", [](double a, double b) { return a >= b; } },
+    { "ifequal", [](double a, double b) { return a == b; } },
+};
+
+// Return the value of a float, integer or boolean value as a double, or
+// false if the value is of some other type.
+bool getScalar(const Value& value, double& scalar)
+{
+    if (value.isA<float>())
+    {
+        scalar = value.asA<float>();
+        return true;
+    }
+    if (value.isA<int>())
+    {
+        scalar = value.asA<int>();
+        return true;
+    }
+    if (value.isA<bool>())
+    {
+        scalar = value.asA<bool>() ? 1.0 : 0.0;
+        return true;
+    }
+    return false;
+}
+
+template <class T> bool getVectorComponents(const Value& value, vector<float>& components)
+{
+    if (!value.isA<T>())
+    {
+        return false;
+    }
+    const T& vec = value.asA<T>();
+    components.assign(vec.begin(), vec.end());
+    return true;
+}
+
+// Return the components of a float, vector or color value, or false if
+// the value is of some other type.
+bool getComponents(const Value& value, vector<float>& components)
+{
+    if (value.isA<float>())
+    {
+        components.assign(1, value.asA<float>());
+        return true;
+    }
+    return getVectorComponents<Vector2>(value, components) ||
+           getVectorComponents<Vector3>(value, components) ||
+           getVectorComponents<Vector4>(value, components) ||
+           getVectorComponents<Color3>(value, components) ||
+           getVectorComponents<Color4>(value, components);
+}
+
+// Create a value of the given float, vector or color type from its components.
+ValuePtr createValue(TypeDesc type, const vector<float>& c)
+{
+    if (type == Type::FLOAT)
+    {
+        return Value::createValue(c[0]);
+    }
+    if (type == Type::VECTOR2)
+    {
+        return Value::createValue(Vector2(c[0], c[1]));
+    }
+    if (type == Type::VECTOR3)
+    {
+        return Value::createValue(Vector3(c[0], c[1], c[2]));
+    }
+    if (type == Type::VECTOR4)
+    {
+        return Value::createValue(Vector4(c[0], c[1], c[2], c[3]));
+    }
+    if (type == Type::COLOR3)
+    {
+        return Value::createValue(Color3(c[0], c[1], c[2]));
+    }
+    if (type == Type::COLOR4)
+    {
+        return Value::createValue(Color4(c[0], c[1], c[2], c[3]));
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
 //
 // ShaderGraph methods
 //
 
 ShaderGraph::ShaderGraph(const ShaderGraph* parent, const string& name, ConstDocumentPtr document) :
     ShaderNode(parent, name),
-    _document(document)
+    _document(document),
+    _specializeUniforms(false)
 {
 }
 
@@ -502,8 +645,14 @@ ShaderGraphPtr ShaderGraph::create(const ShaderGraph* parent, const string& name
         // Clear classification
         graph->_classification = 0;
 
-        // Create input sockets
+        // Create input sockets, identified by the paths of the interface
+        // inputs they represent.
         graph->addInputSockets(*interface, context);
+        const string interfacePath = outputParent->getNamePath();
+        for (ShaderGraphInputSocket* inputSocket : graph->getInputSockets())
+        {
+            inputSocket->setPath(interfacePath + NAME_PATH_SEPARATOR + inputSocket->getName());
+        }
 
         // Create the given output socket
         const TypeDesc outputType = context.getTypeDesc(output->getType());
@@ -615,6 +764,14 @@ ShaderGraphPtr ShaderGraph::create(const ShaderGraph* parent, const string& name
                     input->setColorSpace(colorSpace);
                 }
             }
+            else
+            {
+                // Use the path the input would have on the node, as is done
+                // for the unauthored inputs of other nodes.
+                const string path = node->getNamePath() + NAME_PATH_SEPARATOR + nodedefInput->getName();
+                inputSocket->setPath(path);
+                input->setPath(path);
+            }
 
             // Connect graph socket to the node input
             inputSocket->makeConnection(input);
@@ -641,6 +798,10 @@ ShaderGraphPtr ShaderGraph::create(const ShaderGraph* parent, const string& name
         graph->addUpstreamDependencies(*root, context);
     }
 
+    // Only the interface of the root graph is published as uniforms,
+    // so only the root graph may be specialized.
+    graph->_specializeUniforms = context.getOptions().specializeUniforms;
+
     graph->finalize(context);
 
     return graph;
@@ -910,6 +1071,13 @@ void ShaderGraph::finalize(GenContext& context)
     _inputUnitTransformMap.clear();
     _outputUnitTransformMap.clear();
 
+    // Bake the values of specialized uniforms into the graph, so that
+    // they can be optimized as constants.
+    if (_specializeUniforms)
+    {
+        specializeUniforms(context);
+    }
+
     // Optimize the graph, removing redundant paths.
     optimize(context);
 
@@ -927,7 +1095,7 @@ void ShaderGraph::finalize(GenContext& context)
                 {
                     // Check if the type is editable otherwise we can't
                     // publish the input as an editable uniform.
-                    if (!input->getType().isClosure() && node->isEditable(*input))
+                    if (isPublished(*node, *input, context))
                     {
                         // Use a consistent naming convention: <nodename>_<inputname>
                         // so application side can figure out what uniforms to set
@@ -971,6 +1139,67 @@ void ShaderGraph::disconnect(ShaderNode* node) const
     }
 }
 
+void ShaderGraph::specializeUniforms(GenContext& context)
+{
+    for (ShaderGraphInputSocket* inputSocket : getInputSockets())
+    {
+        // Sockets bound to geometric properties are replaced by geometric
+        // nodes once the graph is created, so they keep their connections.
+        if (!inputSocket->getValue() || !inputSocket->getGeomProp().empty() ||
+            inputSocket->getConnections().empty() || !isEditable(*inputSocket) ||
+            !canSpecialize(*inputSocket, context))
+        {
+            continue;
+        }
+
+        // Iterate a copy of the connection vector since the
+        // original vector will change when breaking connections.
+        ShaderInputVec downstreamConnections = inputSocket->getConnections();
+        for (ShaderInput* downstream : downstreamConnections)
+        {
+            inputSocket->breakConnection(downstream);
+            downstream->setValue(inputSocket->getValue());
+            downstream->setSpecialized();
+        }
+        _specializedUniforms.push_back(inputSocket->getPath());
+    }
+
+    // The complete interface also publishes the unconnected inputs of
+    // nodes, so bake their values in place.
+    if (context.getOptions().shaderInterfaceType == SHADER_INTERFACE_COMPLETE)
+    {
+        for (ShaderNode* node : getNodes())
+        {
+            for (ShaderInput* input : node->getInputs())
+            {
+                if (!input->getConnection() && !input->isSpecialized() &&
+                    node->isEditable(*input) && canSpecialize(*input, context))
+                {
+                    input->setSpecialized();
+                    _specializedUniforms.push_back(input->getPath());
+                }
+            }
+        }
+    }
+}
+
+bool ShaderGraph::canSpecialize(const ShaderPort& port, GenContext& context) const
+{
+    if (!_specializeUniforms || port.getType() == Type::FILENAME || port.getType().isClosure())
+    {
+        return false;
+    }
+    const StringSet& selection = context.getOptions().specializedUniforms;
+    return selection.empty() || selection.count(port.getPath());
+}
+
+bool ShaderGraph::isPublished(const ShaderNode& node, const ShaderInput& input, GenContext& context) const
+{
+    return context.getOptions().shaderInterfaceType == SHADER_INTERFACE_COMPLETE &&
+           !input.getType().isClosure() && node.isEditable(input) &&
+           !input.isSpecialized();
+}
+
 void ShaderGraph::optimize(GenContext& context)
 {
     size_t numEdits = 0;
@@ -1010,6 +1239,30 @@ void ShaderGraph::optimize(GenContext& context)
         // "uniform" in the NodeDef or to handle very specific cases, like FILENAME.
     }
 
+    if (context.getOptions().foldConstantNodes)
+    {
+        // Fold until no further nodes can be evaluated, since each folded
+        // node may leave its downstream nodes with constant inputs.
+        bool folded = true;
+        while (folded)
+        {
+            folded = false;
+            for (ShaderNode* node : getNodes())
+            {
+                if (fold(node, context))
+                {
+                    folded = true;
+                    ++numEdits;
+                }
+            }
+        }
+    }
+
+    if (context.getOptions().mergeDuplicateNodes)
+    {
+        numEdits += mergeDuplicateNodes(context);
+    }
+
     if (numEdits > 0)
     {
         std::set<ShaderNode*> usedNodesSet;
@@ -1091,8 +1344,206 @@ void ShaderGraph::bypass(ShaderNode* node, size_t inputIndex, size_t outputIndex
             {
                 downstream->setColorSpace(inputColorSpace);
             }
+            if (input->isSpecialized())
+            {
+                downstream->setSpecialized();
+            }
+        }
+    }
+}
+
+bool ShaderGraph::fold(ShaderNode* node, GenContext& context)
+{
+    auto conditional = FOLD_CONDITIONALS.find(node->getNodeString());
+    if (conditional != FOLD_CONDITIONALS.end())
+    {
+        return foldConditional(node, conditional->second, context);
+    }
+
+    auto it = FOLD_OPERATIONS.find(node->getNodeString());
+    if (it == FOLD_OPERATIONS.end() || node->numOutputs() != 1)
+    {
+        return false;
+    }
+    const FoldOperation& operation = it->second;
+
+    // Nodes whose output is unused have nothing to fold into.
+    ShaderOutput* output = node->getOutput();
+    const TypeDesc outputType = output->getType();
+    const size_t size = outputType.getSize();
+    if (output->getConnections().empty() || outputType.getBaseType() != TypeDesc::BASETYPE_FLOAT ||
+        !(outputType.isScalar() || outputType.isFloat2() || outputType.isFloat3() || outputType.isFloat4()))
+    {
+        return false;
+    }
+
+    // Every input must hold a value that will not be published as a uniform,
+    // with either a single component or one component per output component.
+    vector<vector<float>> args(operation.inputs.size());
+    bool specialized = false;
+    for (size_t i = 0; i < operation.inputs.size(); i++)
+    {
+        const ShaderInput* input = node->getInput(operation.inputs[i]);
+        if (!input || input->getConnection() || !input->getValue() ||
+            isPublished(*node, *input, context) ||
+            !getComponents(*input->getValue(), args[i]) ||
+            (args[i].size() != 1 && args[i].size() != size))
+        {
+            return false;
+        }
+        specialized = specialized || input->isSpecialized();
+    }
+
+    // Evaluate each component, leaving the node to the shader if any result
+    // is undefined, as the behavior of the shading language may differ.
+    vector<float> result(size);
+    float componentArgs[MAX_FOLD_INPUTS];
+    for (size_t c = 0; c < size; c++)
+    {
+        for (size_t i = 0; i < args.size(); i++)
+        {
+            componentArgs[i] = args[i].size() == 1 ? args[i][0] : args[i][c];
+        }
+        result[c] = operation.function(componentArgs);
+        if (!std::isfinite(result[c]))
+        {
+            return false;
+        }
+    }
+
+    ValuePtr value = createValue(outputType, result);
+    if (!value)
+    {
+        return false;
+    }
+
+    // Push the result to the downstream inputs, iterating a copy of the
+    // connection vector since breaking connections changes the original.
+    ShaderInputVec downstreamConnections = output->getConnections();
+    for (ShaderInput* downstream : downstreamConnections)
+    {
+        output->breakConnection(downstream);
+        downstream->setValue(value);
+        if (specialized)
+        {
+            downstream->setSpecialized();
+        }
+    }
+    return true;
+}
+
+bool ShaderGraph::foldConditional(ShaderNode* node, bool (*compare)(double, double), GenContext& context)
+{
+    const ShaderInput* value1 = node->getInput("value1");
+    const ShaderInput* value2 = node->getInput("value2");
+    if (!value1 || !value2 || node->numOutputs() != 1 || node->getOutput()->getConnections().empty())
+    {
+        return false;
+    }
+
+    // Both operands must hold values that will not be published as uniforms.
+    double operands[2];
+    const ShaderInput* operandInputs[2] = { value1, value2 };
+    for (size_t i = 0; i < 2; i++)
+    {
+        const ShaderInput* input = operandInputs[i];
+        if (input->getConnection() || !input->getValue() || isPublished(*node, *input, context) ||
+            !getScalar(*input->getValue(), operands[i]))
+        {
+            return false;
+        }
+    }
+
+    // Replace the node by its selected branch, leaving the other branch
+    // unused.  Branches that would be published as uniforms are kept.
+    const string selectedName = compare(operands[0], operands[1]) ? "in1" : "in2";
+    for (size_t i = 0; i < node->numInputs(); i++)
+    {
+        const ShaderInput* selected = node->getInput(i);
+        if (selected->getName() == selectedName)
+        {
+            if (!selected->getConnection() && (!selected->getValue() || isPublished(*node, *selected, context)))
+            {
+                return false;
+            }
+            bypass(node, i);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ShaderGraph::mergeDuplicateNodes(GenContext& context)
+{
+    // Visit upstream nodes first, so that the inputs of each node are
+    // already connected to the surviving copies of their upstream nodes.
+    topologicalSort();
+
+    std::unordered_map<string, ShaderNode*> signatures;
+    size_t numMerged = 0;
+    for (ShaderNode* node : _nodeOrder)
+    {
+        // Describe the node by its implementation, outputs and inputs.
+        string signature = std::to_string(reinterpret_cast<uintptr_t>(&node->getImplementation())) + "\n";
+        bool canMerge = true;
+        for (const ShaderOutput* output : node->getOutputs())
+        {
+            if (output->getType().isClosure())
+            {
+                canMerge = false;
+                break;
+            }
+            signature += output->getName() + " " + output->getType().getName() + "\n";
+        }
+        for (const ShaderInput* input : node->getInputs())
+        {
+            if (!canMerge)
+            {
+                break;
+            }
+            signature += input->getName() + " " + input->getType().getName();
+            if (const ShaderOutput* upstream = input->getConnection())
+            {
+                signature += " <" + std::to_string(reinterpret_cast<uintptr_t>(upstream));
+            }
+            else if (!isPublished(*node, *input, context))
+            {
+                signature += " =" + input->getValueString() + " " + input->getColorSpace() + " " + input->getUnit();
+            }
+            else
+            {
+                // This input will be published as a uniform of its own.
+                canMerge = false;
+            }
+            signature += "\n";
+        }
+        if (!canMerge)
+        {
+            continue;
+        }
+
+        auto it = signatures.emplace(signature, node);
+        if (it.second)
+        {
+            continue;
+        }
+
+        // Reconnect the downstream inputs of this duplicate to the first
+        // equivalent node, leaving this node unused.
+        ShaderNode* original = it.first->second;
+        for (size_t i = 0; i < node->numOutputs(); i++)
+        {
+            ShaderOutput* output = node->getOutput(i);
+            ShaderInputVec downstreamConnections = output->getConnections();
+            for (ShaderInput* downstream : downstreamConnections)
+            {
+                output->breakConnection(downstream);
+                downstream->makeConnection(original->getOutput(i));
+            }
         }
+        ++numMerged;
     }
+    return numMerged;
 }
 
 void ShaderGraph::topologicalSort()
@@ -125,6 +125,10 @@ class MX_GENSHADER_API ShaderGraph : public ShaderNode
     /// Return the map of unique identifiers used in the scope of this graph.
     IdentifierMap& getIdentifierMap() { return _identifiers; }
 
+    /// Return the element paths of the public uniforms whose values were
+    /// baked into this graph when the specializeUniforms option is enabled.
+    const StringVec& getSpecializedUniforms() const { return _specializedUniforms; }
+
   protected:
     /// Create node connections corresponding to the connection between a pair of elements.
     /// @param downstreamElement Element representing the node to connect to.
@@ -178,6 +182,35 @@ class MX_GENSHADER_API ShaderGraph : public ShaderNode
     /// with the output's downstream connections.
     void bypass(ShaderNode* node, size_t inputIndex, size_t outputIndex = 0);
 
+    /// Fold a node, if it is a standard library math node whose inputs all
+    /// hold constant values, by pushing the value of its evaluated output to
+    /// the output's downstream inputs, or a conditional node whose operands
+    /// hold constant values.  Returns true if the node was folded.
+    bool fold(ShaderNode* node, GenContext& context);
+
+    /// Fold a conditional node whose operands hold constant values, by
+    /// bypassing the node to the input selected by the given comparison.
+    /// Returns true if the node was folded.
+    bool foldConditional(ShaderNode* node, bool (*compare)(double, double), GenContext& context);
+
+    /// Merge nodes that compute identical values, visiting nodes in
+    /// topological order and reconnecting the outputs of each duplicate
+    /// to the first equivalent node.  Returns the number of merged nodes.
+    size_t mergeDuplicateNodes(GenContext& context);
+
+    /// Bake the values of specialized uniforms into the graph, pushing the
+    /// values of input sockets to their downstream inputs, and marking the
+    /// node inputs that would otherwise be published as specialized.
+    void specializeUniforms(GenContext& context);
+
+    /// Return true if the given port is selected for specialization,
+    /// baking its value into this graph rather than publishing a uniform.
+    bool canSpecialize(const ShaderPort& port, GenContext& context) const;
+
+    /// Return true if the given unconnected input of a node in this graph
+    /// is to be published as a shader uniform.
+    bool isPublished(const ShaderNode& node, const ShaderInput& input, GenContext& context) const;
+
     /// For inputs and outputs in the graph set the variable names to be used
     /// in generated code. Making sure variable names are valid and unique
     /// to avoid name conflicts during shader generation.
@@ -199,6 +232,8 @@ class MX_GENSHADER_API ShaderGraph : public ShaderNode
     std::unordered_map<string, ShaderNodePtr> _nodeMap;
     std::vector<ShaderNode*> _nodeOrder;
     IdentifierMap _identifiers;
+    bool _specializeUniforms;
+    StringVec _specializedUniforms;
 
     // Temporary storage for inputs that require color transformations
     std::vector<std::pair<ShaderInput*, ColorSpaceTransform>> _inputColorTransformMap;
@@ -172,6 +172,7 @@ ShaderNode::ShaderNode(const ShaderGraph* parent, const string& name) :
 ShaderNodePtr ShaderNode::create(const ShaderGraph* parent, const string& name, const NodeDef& nodeDef, GenContext& context)
 {
     ShaderNodePtr newNode = std::make_shared<ShaderNode>(parent, name);
+    newNode->_nodeString = nodeDef.getQualifiedName(nodeDef.getNodeString());
 
     const ShaderGenerator& shadergen = context.getShaderGenerator();
 
@@ -425,12 +426,12 @@ void ShaderNode::createMetadata(const NodeDef& nodeDef, GenContext& context)
 
     // Set metadata on the node according to the nodedef attributes.
     ShaderMetadataVecPtr nodeMetadataStorage = getMetadata();
-    for (const string& nodedefAttr : nodeDef.getAttributeNames())
+    for (size_t i = 0; i < nodeDef.getAttributeCount(); i++)
     {
-        const ShaderMetadata* metadataEntry = registry->findMetadata(nodedefAttr);
+        const ShaderMetadata* metadataEntry = registry->findMetadata(nodeDef.getAttributeName(i));
         if (metadataEntry)
         {
-            const string& attrValue = nodeDef.getAttribute(nodedefAttr);
+            const string& attrValue = nodeDef.getAttributeValue(i);
             if (!attrValue.empty())
             {
                 ValuePtr value = metadataEntry->type.createValueFromStrings(attrValue);
@@ -459,12 +460,12 @@ void ShaderNode::createMetadata(const NodeDef& nodeDef, GenContext& context)
         {
             ShaderMetadataVecPtr inputMetadataStorage = input->getMetadata();
 
-            for (const string& nodedefPortAttr : nodedefPort->getAttributeNames())
+            for (size_t i = 0; i < nodedefPort->getAttributeCount(); i++)
             {
-                const ShaderMetadata* metadataEntry = registry->findMetadata(nodedefPortAttr);
+                const ShaderMetadata* metadataEntry = registry->findMetadata(nodedefPort->getAttributeName(i));
                 if (metadataEntry)
                 {
-                    const string& attrValue = nodedefPort->getAttribute(nodedefPortAttr);
+                    const string& attrValue = nodedefPort->getAttributeValue(i);
                     if (!attrValue.empty())
                     {
                         const TypeDesc type = metadataEntry->type != Type::NONE ? metadataEntry->type : input->getType();
@@ -116,6 +116,7 @@ class MX_GENSHADER_API ShaderPortFlag
     static const uint32_t EMITTED        = 1u << 1;
     static const uint32_t BIND_INPUT     = 1u << 2;
     static const uint32_t AUTHORED_VALUE = 1u << 3;
+    static const uint32_t SPECIALIZED    = 1u << 4;
 };
 
 /// @class ShaderPort
@@ -242,6 +243,13 @@ class MX_GENSHADER_API ShaderPort : public std::enable_shared_from_this<ShaderPo
     // Has the value been overridden.
     bool hasAuthoredValue() const { return (_flags & ShaderPortFlag::AUTHORED_VALUE) != 0; }
 
+    /// Set the specialized flag on this port, marking a value that was
+    /// baked into the graph in place of a public uniform.
+    void setSpecialized() { _flags |= ShaderPortFlag::SPECIALIZED; }
+
+    /// Return the specialized flag on this port.
+    bool isSpecialized() const { return (_flags & ShaderPortFlag::SPECIALIZED) != 0; }
+
     /// Set the metadata vector.
     void setMetadata(ShaderMetadataVecPtr metadata) { _metadata = metadata; }
 
@@ -430,6 +438,14 @@ class MX_GENSHADER_API ShaderNode
         return _name;
     }
 
+    /// Return the node string of the nodedef this node was created from,
+    /// qualified by its namespace, or an empty string if this node was not
+    /// created from a nodedef.
+    const string& getNodeString() const
+    {
+        return _nodeString;
+    }
+
     /// Return the implementation used for this node.
     const ShaderNodeImpl& getImplementation() const
     {
@@ -495,6 +511,7 @@ class MX_GENSHADER_API ShaderNode
 
     const ShaderGraph* _parent;
     string _name;
+    string _nodeString;
     uint32_t _classification;
 
     std::unordered_map<string, ShaderInputPtr> _inputMap;
@@ -313,32 +313,37 @@ void ShaderStage::addComment(const string& str)
 
 void ShaderStage::addBlock(const string& str, const FilePath& sourceFilename, GenContext& context)
 {
-    const string& INCLUDE = _syntax->getIncludeStatement();
-    const string& QUOTE   = _syntax->getStringQuote();
-
     // Add each line in the block separately to get correct indentation.
     StringStream stream(str);
     for (string line; std::getline(stream, line);)
     {
-        size_t pos = line.find(INCLUDE);
-        if (pos != string::npos)
+        addBlockLine(line, sourceFilename, context);
+    }
+}
+
+void ShaderStage::addBlockLine(const string& line, const FilePath& sourceFilename, GenContext& context)
+{
+    const string& INCLUDE = _syntax->getIncludeStatement();
+    const string& QUOTE   = _syntax->getStringQuote();
+
+    size_t pos = line.find(INCLUDE);
+    if (pos != string::npos)
+    {
+        size_t startQuote = line.find_first_of(QUOTE);
+        size_t endQuote = line.find_last_of(QUOTE);
+        if (startQuote != string::npos && endQuote != string::npos && endQuote > startQuote)
         {
-            size_t startQuote = line.find_first_of(QUOTE);
-            size_t endQuote = line.find_last_of(QUOTE);
-            if (startQuote != string::npos && endQuote != string::npos && endQuote > startQuote)
+            size_t length = (endQuote - startQuote) - 1;
+            if (length)
             {
-                size_t length = (endQuote - startQuote) - 1;
-                if (length)
-                {
-                    const string filename = line.substr(startQuote + 1, length);
-                    addInclude(filename, sourceFilename, context);
-                }
+                const string filename = line.substr(startQuote + 1, length);
+                addInclude(filename, sourceFilename, context);
             }
         }
-        else
-        {
-            addLine(line, false);
-        }
+    }
+    else
+    {
+        addLine(line, false);
     }
 }
 
@@ -350,13 +355,18 @@ void ShaderStage::addInclude(const FilePath& includeFilename, const FilePath& so
 
     if (!_includes.count(resolvedFile))
     {
-        string content = readFile(resolvedFile);
-        if (content.empty())
+        ConstSourceFilePtr sourceFile = context.getSourceCache()->getSourceFile(resolvedFile);
+        if (!sourceFile)
         {
             throw ExceptionShaderGenError("Could not find include file: '" + includeFilename.asString() + "'");
         }
         _includes.insert(resolvedFile);
-        addBlock(content, resolvedFile, context);
+
+        // Add the cached lines of the file, avoiding a re-split of its content.
+        for (const string& line : sourceFile->getLines())
+        {
+            addBlockLine(line, resolvedFile, context);
+        }
     }
 }
 
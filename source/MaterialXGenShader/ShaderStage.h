@@ -296,6 +296,9 @@ class MX_GENSHADER_API ShaderStage
     }
 
   private:
+    /// Add a single line of a code block, expanding any include statement.
+    void addBlockLine(const string& line, const FilePath& sourceFilename, GenContext& context);
+
     /// Name of the stage
     const string _name;
 
@@ -335,6 +338,7 @@ class MX_GENSHADER_API ShaderStage
     /// Resulting source code for this stage.
     string _code;
 
+    friend class Shader;
     friend class ShaderGenerator;
 };
 
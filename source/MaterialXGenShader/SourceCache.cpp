@@ -0,0 +1,87 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <MaterialXGenShader/SourceCache.h>
+
+#include <MaterialXFormat/Util.h>
+
+#include <sstream>
+
+MATERIALX_NAMESPACE_BEGIN
+
+//
+// SourceFile methods
+//
+
+SourceFile::SourceFile(const string& content) :
+    _content(content)
+{
+    StringStream stream(_content);
+    for (string line; std::getline(stream, line);)
+    {
+        _lines.push_back(std::move(line));
+    }
+}
+
+//
+// SourceCache methods
+//
+
+SourceCache::SourceCache() :
+    _hitCount(0),
+    _missCount(0)
+{
+}
+
+SourceCache::~SourceCache()
+{
+}
+
+ConstSourceFilePtr SourceCache::getSourceFile(const FilePath& filePath)
+{
+    const string key = filePath.asString();
+    const int64_t modificationTime = filePath.getModificationTime();
+    const uint64_t fileSize = filePath.getFileSize();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(key);
+        if (it != _entries.end() && it->second.modificationTime == modificationTime && it->second.fileSize == fileSize)
+        {
+            _hitCount++;
+            return it->second.file;
+        }
+    }
+
+    // Read the file outside of the lock, so that other threads are not
+    // blocked on file system access.
+    _missCount++;
+    string content = readFile(filePath);
+    if (content.empty())
+    {
+        return nullptr;
+    }
+    ConstSourceFilePtr file = std::make_shared<SourceFile>(content);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries[key] = { modificationTime, fileSize, file };
+    return file;
+}
+
+void SourceCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _hitCount = 0;
+    _missCount = 0;
+}
+
+size_t SourceCache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+MATERIALX_NAMESPACE_END
@@ -0,0 +1,113 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef MATERIALX_SOURCECACHE_H
+#define MATERIALX_SOURCECACHE_H
+
+/// @file
+/// Cache of source code files used during shader generation
+
+#include <MaterialXGenShader/Export.h>
+
+#include <MaterialXFormat/File.h>
+
+#include <atomic>
+#include <mutex>
+
+MATERIALX_NAMESPACE_BEGIN
+
+class SourceCache;
+class SourceFile;
+
+/// Shared pointer to a SourceCache
+using SourceCachePtr = shared_ptr<SourceCache>;
+
+/// Shared pointer to a constant SourceFile
+using ConstSourceFilePtr = shared_ptr<const SourceFile>;
+
+/// @class SourceFile
+/// The contents of a source code file, stored both as a single string and
+/// as a sequence of lines.
+class MX_GENSHADER_API SourceFile
+{
+  public:
+    SourceFile(const string& content);
+
+    /// Return the full contents of the file.
+    const string& getContent() const
+    {
+        return _content;
+    }
+
+    /// Return the contents of the file split into lines, with line
+    /// terminators removed.
+    const StringVec& getLines() const
+    {
+        return _lines;
+    }
+
+  private:
+    string _content;
+    StringVec _lines;
+};
+
+/// @class SourceCache
+/// A thread-safe cache of source code files read during shader generation,
+/// keyed by resolved file path, modification time and size.  A single cache may
+/// be shared between any number of generation contexts, so that each
+/// source file is read and split into lines only once.
+class MX_GENSHADER_API SourceCache
+{
+  public:
+    SourceCache();
+    ~SourceCache();
+
+    /// Create a new source cache.
+    static SourceCachePtr create()
+    {
+        return std::make_shared<SourceCache>();
+    }
+
+    /// Return the contents of the given source file, reading it from disk
+    /// if it is not present in the cache or has been modified since it was
+    /// cached.  If the file cannot be read, then an empty shared pointer is
+    /// returned.
+    ConstSourceFilePtr getSourceFile(const FilePath& filePath);
+
+    /// Clear all files from the cache, and reset its hit and miss counts.
+    void clear();
+
+    /// Return the number of files currently held in the cache.
+    size_t size() const;
+
+    /// Return the number of lookups that were served from the cache.
+    size_t getHitCount() const
+    {
+        return _hitCount;
+    }
+
+    /// Return the number of lookups that required the file to be read.
+    size_t getMissCount() const
+    {
+        return _missCount;
+    }
+
+  private:
+    struct Entry
+    {
+        int64_t modificationTime;
+        uint64_t fileSize;
+        ConstSourceFilePtr file;
+    };
+
+    std::unordered_map<string, Entry> _entries;
+    mutable std::mutex _mutex;
+    std::atomic<size_t> _hitCount;
+    std::atomic<size_t> _missCount;
+};
+
+MATERIALX_NAMESPACE_END
+
+#endif
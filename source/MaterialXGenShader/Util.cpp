@@ -5,6 +5,8 @@
 
 #include <MaterialXGenShader/Util.h>
 
+#include <MaterialXGenShader/GenContext.h>
+
 MATERIALX_NAMESPACE_BEGIN
 
 /// Gaussian kernel weights for different kernel sizes.
@@ -448,6 +450,44 @@ vector<TypedElementPtr> findRenderableElements(ConstDocumentPtr doc)
     return renderableElements;
 }
 
+vector<ShaderPtr> generateShaders(const vector<TypedElementPtr>& elements, GenContext& context, unsigned int threadCount)
+{
+    vector<ShaderPtr> shaders(elements.size());
+    if (getParallelWorkerCount(elements.size(), threadCount) <= 1)
+    {
+        for (size_t i = 0; i < elements.size(); i++)
+        {
+            const string shaderName = createValidName(elements[i]->getNamePath());
+            shaders[i] = context.getShaderGenerator().generate(shaderName, elements[i], context);
+        }
+        return shaders;
+    }
+
+    // Generate the first shader before starting worker threads, so that any
+    // state the generator initializes on first use is not written concurrently.
+    {
+        GenContext workerContext(context);
+        const string shaderName = createValidName(elements[0]->getNamePath());
+        shaders[0] = workerContext.getShaderGenerator().generate(shaderName, elements[0], workerContext);
+    }
+
+    // Generate the remaining shaders in parallel, with a copy of the context
+    // per worker.
+    vector<std::unique_ptr<GenContext>> workerContexts(getParallelWorkerCount(elements.size() - 1, threadCount));
+    parallelFor(elements.size() - 1, threadCount, [&](size_t index, unsigned int worker)
+    {
+        std::unique_ptr<GenContext>& workerContext = workerContexts[worker];
+        if (!workerContext)
+        {
+            workerContext = std::make_unique<GenContext>(context);
+        }
+        const size_t i = index + 1;
+        const string shaderName = createValidName(elements[i]->getNamePath());
+        shaders[i] = workerContext->getShaderGenerator().generate(shaderName, elements[i], *workerContext);
+    });
+    return shaders;
+}
+
 InputPtr getNodeDefInput(InputPtr nodeInput, const string& target)
 {
     ElementPtr parent = nodeInput ? nodeInput->getParent() : nullptr;
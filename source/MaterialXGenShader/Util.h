@@ -17,6 +17,7 @@
 
 MATERIALX_NAMESPACE_BEGIN
 
+class GenContext;
 class ShaderGenerator;
 
 /// Gaussian kernel weights for different kernel sizes.
@@ -62,6 +63,29 @@ MX_GENSHADER_API vector<TypedElementPtr> findRenderableMaterialNodes(ConstDocume
 /// @return A vector of renderable elements
 MX_GENSHADER_API vector<TypedElementPtr> findRenderableElements(ConstDocumentPtr doc);
 
+/// Generate shaders for the given renderable elements, returning the shaders
+/// in the same order as the elements.  Each shader is named after the name
+/// path of its element.
+///
+/// When more than one thread is used, each worker thread generates shaders
+/// with its own copy of the given context.  The copies share the shader
+/// generator, source cache, user data and any node implementations already
+/// cached in the given context, while node implementations created during
+/// generation are kept per thread.  User data that is modified during
+/// generation, such as a resource binding context, is not supported when
+/// more than one thread is used, and documents must not be edited while
+/// generation is in progress.
+/// @param elements Renderable elements, e.g. from findRenderableElements
+/// @param context Context for shader generation, left unmodified when
+///    more than one thread is used
+/// @param threadCount The number of threads to use. A value of zero selects
+///    the number of hardware threads, and a value of one generates all
+///    shaders serially with the given context.  Defaults to one.
+/// @return A vector of generated shaders
+MX_GENSHADER_API vector<ShaderPtr> generateShaders(const vector<TypedElementPtr>& elements,
+                                                   GenContext& context,
+                                                   unsigned int threadCount = 1);
+
 /// Given a node input, return the corresponding input within its matching nodedef.
 /// The optional target string can be used to guide the selection of nodedef declarations.
 MX_GENSHADER_API InputPtr getNodeDefInput(InputPtr nodeInput, const string& target);
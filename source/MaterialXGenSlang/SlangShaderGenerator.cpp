@@ -518,14 +518,14 @@ void SlangShaderGenerator::emitPixelStage(const ShaderGraph& graph, GenContext&
     // depending on the vertical flip flag.
     if (context.getOptions().fileTextureVerticalFlip)
     {
-        _tokenSubstitutions[ShaderGenerator::T_FILE_TRANSFORM_UV] = "mx_transform_uv_vflip.glsl";
+        setTokenSubstitution(ShaderGenerator::T_FILE_TRANSFORM_UV, "mx_transform_uv_vflip.glsl");
     }
     else
     {
-        _tokenSubstitutions[ShaderGenerator::T_FILE_TRANSFORM_UV] = "mx_transform_uv.glsl";
+        setTokenSubstitution(ShaderGenerator::T_FILE_TRANSFORM_UV, "mx_transform_uv.glsl");
     }
 
-    _tokenSubstitutions[HW::T_TEX_SAMPLER_SIGNATURE] = "SamplerTexture2D tex_sampler";
+    setTokenSubstitution(HW::T_TEX_SAMPLER_SIGNATURE, "SamplerTexture2D tex_sampler");
 
     emitLightFunctionDefinitions(graph, context, stage);
 
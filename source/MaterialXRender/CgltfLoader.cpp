@@ -426,7 +426,7 @@ bool CgltfLoader::load(const FilePath& filePath, MeshList& meshList, bool texcoo
                 }
                 else
                 {
-                    indexCount = positionStream->getData().size();
+                    indexCount = positionStream->getSize();
                 }
                 size_t faceCount = indexCount / FACE_VERTEX_COUNT;
                 part->setFaceCount(faceCount);
@@ -437,19 +437,19 @@ bool CgltfLoader::load(const FilePath& filePath, MeshList& meshList, bool texcoo
                 {
                     std::cout << "** Read indexing: Count = " << std::to_string(indexCount) << std::endl;
                 }
+                indices.resize(indexCount);
                 if (indexAccessor)
                 {
                     for (cgltf_size i = 0; i < indexCount; i++)
                     {
-                        uint32_t vertexIndex = static_cast<uint32_t>(cgltf_accessor_read_index(indexAccessor, i));
-                        indices.push_back(vertexIndex);
+                        indices[i] = static_cast<uint32_t>(cgltf_accessor_read_index(indexAccessor, i));
                     }
                 }
                 else
                 {
                     for (cgltf_size i = 0; i < indexCount; i++)
                     {
-                        indices.push_back(static_cast<uint32_t>(i));
+                        indices[i] = static_cast<uint32_t>(i);
                     }
                 }
                 mesh->addPartition(part);
@@ -480,6 +480,13 @@ bool CgltfLoader::load(const FilePath& filePath, MeshList& meshList, bool texcoo
                     }
                 }
 
+                // Weld the vertices of non-indexed primitives.  Primitives without
+                // normals are left unwelded, as glTF requires flat normals for them.
+                if (!indexAccessor && normalStream)
+                {
+                    mesh->weldVertices();
+                }
+
                 // Generate tangents, normals and texture coordinates if none are provided
                 if (!normalStream)
                 {
@@ -0,0 +1,379 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <MaterialXRender/GeometryCache.h>
+
+#include <MaterialXCore/Exception.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+
+MATERIALX_NAMESPACE_BEGIN
+
+namespace
+{
+
+// A cache file consists of a header describing its source file, followed by
+// each mesh with its streams and partitions.  Integers and buffers are stored
+// in native byte order, and buffers are aligned to four bytes within the file,
+// so that they may be copied directly from a mapped view.
+const char CACHE_MAGIC[8] = { 'M', 'T', 'L', 'X', 'G', 'E', 'O', '\0' };
+const uint32_t CACHE_FORMAT_VERSION = 1;
+const uint32_t CACHE_BYTE_ORDER_MARK = 0x01020304;
+const string CACHE_EXTENSION = "mtlxgeo";
+const size_t CACHE_ALIGNMENT = 4;
+
+// A description of the state of a source file, against which cache files
+// are validated.
+struct SourceKey
+{
+    string path;
+    int64_t modificationTime = 0;
+    uint64_t size = 0;
+    uint32_t texcoordVerticalFlip = 0;
+};
+
+SourceKey getSourceKey(const FilePath& sourcePath, bool texcoordVerticalFlip)
+{
+    FilePath absolutePath = sourcePath.isAbsolute() ? sourcePath : FilePath::getCurrentPath() / sourcePath;
+
+    SourceKey key;
+    key.path = absolutePath.getNormalized().asString(FilePath::FormatPosix);
+    key.modificationTime = sourcePath.getModificationTime();
+    key.size = sourcePath.getFileSize();
+    key.texcoordVerticalFlip = texcoordVerticalFlip ? 1 : 0;
+    return key;
+}
+
+uint64_t hashString(const string& str)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (char c : str)
+    {
+        hash = (hash ^ (unsigned char) c) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+class CacheWriter
+{
+  public:
+    void writeCache(const SourceKey& key, const MeshList& meshList)
+    {
+        _stream.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        write(CACHE_FORMAT_VERSION);
+        write(CACHE_BYTE_ORDER_MARK);
+        writeSourceKey(key);
+
+        write((uint32_t) meshList.size());
+        for (MeshPtr mesh : meshList)
+        {
+            writeString(mesh->getName());
+            write((uint64_t) mesh->getVertexCount());
+            const Vector3& minBounds = mesh->getMinimumBounds();
+            const Vector3& maxBounds = mesh->getMaximumBounds();
+            const Vector3& sphereCenter = mesh->getSphereCenter();
+            const float bounds[10] = { minBounds[0], minBounds[1], minBounds[2],
+                                       maxBounds[0], maxBounds[1], maxBounds[2],
+                                       sphereCenter[0], sphereCenter[1], sphereCenter[2],
+                                       mesh->getSphereRadius() };
+            writeBuffer(bounds, 10);
+
+            write((uint32_t) mesh->getStreams().size());
+            for (MeshStreamPtr stream : mesh->getStreams())
+            {
+                writeString(stream->getName());
+                writeString(stream->getType());
+                write((uint32_t) stream->getIndex());
+                write((uint32_t) stream->getStride());
+                write((uint64_t) stream->getData().size());
+                writeBuffer(stream->getData().data(), stream->getData().size());
+            }
+
+            write((uint32_t) mesh->getPartitionCount());
+            for (size_t i = 0; i < mesh->getPartitionCount(); i++)
+            {
+                MeshPartitionPtr part = mesh->getPartition(i);
+                writeString(part->getName());
+                write((uint32_t) part->getSourceNames().size());
+                for (const string& sourceName : part->getSourceNames())
+                {
+                    writeString(sourceName);
+                }
+                write((uint64_t) part->getFaceCount());
+                write((uint64_t) part->getIndices().size());
+                writeBuffer(part->getIndices().data(), part->getIndices().size());
+            }
+        }
+    }
+
+    void writeSourceKey(const SourceKey& key)
+    {
+        writeString(key.path);
+        write(key.modificationTime);
+        write(key.size);
+        write(key.texcoordVerticalFlip);
+    }
+
+    string getData() const
+    {
+        return _stream.str();
+    }
+
+  private:
+    template <class T> void write(T value)
+    {
+        _stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void writeString(const string& str)
+    {
+        write((uint32_t) str.size());
+        _stream.write(str.data(), (std::streamsize) str.size());
+    }
+
+    template <class T> void writeBuffer(const T* data, size_t count)
+    {
+        static_assert(sizeof(T) == CACHE_ALIGNMENT, "Buffer elements must match the cache alignment");
+        size_t padding = (CACHE_ALIGNMENT - (size_t) _stream.tellp() % CACHE_ALIGNMENT) % CACHE_ALIGNMENT;
+        const char zeros[CACHE_ALIGNMENT] = {};
+        _stream.write(zeros, (std::streamsize) padding);
+        _stream.write(reinterpret_cast<const char*>(data), (std::streamsize) (count * sizeof(T)));
+    }
+
+  private:
+    std::ostringstream _stream;
+};
+
+class CacheReader
+{
+  public:
+    CacheReader(const char* buffer, size_t size) :
+        _begin(buffer),
+        _data(buffer),
+        _end(buffer + size)
+    {
+    }
+
+    void readCache(const SourceKey& key, const string& sourceUri, MeshList& meshList)
+    {
+        require(sizeof(CACHE_MAGIC));
+        if (std::memcmp(_data, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+        {
+            throw Exception("Invalid geometry cache header");
+        }
+        _data += sizeof(CACHE_MAGIC);
+        if (read<uint32_t>() != CACHE_FORMAT_VERSION || read<uint32_t>() != CACHE_BYTE_ORDER_MARK)
+        {
+            throw Exception("Unsupported geometry cache version");
+        }
+        if (readString() != key.path ||
+            read<int64_t>() != key.modificationTime ||
+            read<uint64_t>() != key.size ||
+            read<uint32_t>() != key.texcoordVerticalFlip)
+        {
+            throw Exception("Geometry cache does not match its source");
+        }
+
+        uint32_t meshCount = read<uint32_t>();
+        for (uint32_t m = 0; m < meshCount; m++)
+        {
+            MeshPtr mesh = Mesh::create(readString());
+            mesh->setSourceUri(sourceUri);
+            mesh->setVertexCount((size_t) read<uint64_t>());
+            float bounds[10];
+            readBuffer(bounds, 10);
+            mesh->setMinimumBounds(Vector3(bounds[0], bounds[1], bounds[2]));
+            mesh->setMaximumBounds(Vector3(bounds[3], bounds[4], bounds[5]));
+            mesh->setSphereCenter(Vector3(bounds[6], bounds[7], bounds[8]));
+            mesh->setSphereRadius(bounds[9]);
+
+            uint32_t streamCount = read<uint32_t>();
+            for (uint32_t s = 0; s < streamCount; s++)
+            {
+                const string name = readString();
+                const string type = readString();
+                uint32_t index = read<uint32_t>();
+                MeshStreamPtr stream = MeshStream::create(name, type, index);
+                stream->setStride(read<uint32_t>());
+                MeshFloatBuffer& data = stream->getData();
+                data.resize(readCount(sizeof(float)));
+                readBuffer(data.data(), data.size());
+                mesh->addStream(stream);
+            }
+
+            uint32_t partitionCount = read<uint32_t>();
+            for (uint32_t p = 0; p < partitionCount; p++)
+            {
+                MeshPartitionPtr part = MeshPartition::create();
+                part->setName(readString());
+                uint32_t sourceNameCount = read<uint32_t>();
+                for (uint32_t i = 0; i < sourceNameCount; i++)
+                {
+                    part->addSourceName(readString());
+                }
+                part->setFaceCount((size_t) read<uint64_t>());
+                MeshIndexBuffer& indices = part->getIndices();
+                indices.resize(readCount(sizeof(uint32_t)));
+                readBuffer(indices.data(), indices.size());
+                mesh->addPartition(part);
+            }
+
+            meshList.push_back(mesh);
+        }
+
+        if (_data != _end)
+        {
+            throw Exception("Unexpected data at the end of geometry cache");
+        }
+    }
+
+  private:
+    void require(size_t size)
+    {
+        if ((size_t) (_end - _data) < size)
+        {
+            throw Exception("Unexpected end of geometry cache");
+        }
+    }
+
+    template <class T> T read()
+    {
+        require(sizeof(T));
+        T value;
+        std::memcpy(&value, _data, sizeof(T));
+        _data += sizeof(T);
+        return value;
+    }
+
+    string readString()
+    {
+        uint32_t length = read<uint32_t>();
+        require(length);
+        string str(_data, length);
+        _data += length;
+        return str;
+    }
+
+    // Read an element count, validating it against the remaining data.
+    size_t readCount(size_t elementSize)
+    {
+        uint64_t count = read<uint64_t>();
+        if (count > (uint64_t) (_end - _data) / elementSize)
+        {
+            throw Exception("Invalid buffer size in geometry cache");
+        }
+        return (size_t) count;
+    }
+
+    template <class T> void readBuffer(T* data, size_t count)
+    {
+        _data += (CACHE_ALIGNMENT - (size_t) (_data - _begin) % CACHE_ALIGNMENT) % CACHE_ALIGNMENT;
+        require(count * sizeof(T));
+        if (count)
+        {
+            std::memcpy(data, _data, count * sizeof(T));
+        }
+        _data += count * sizeof(T);
+    }
+
+  private:
+    const char* _begin;
+    const char* _data;
+    const char* _end;
+};
+
+} // anonymous namespace
+
+//
+// GeometryCache methods
+//
+
+GeometryCache::GeometryCache(const FilePath& directory) :
+    _directory(directory),
+    _hitCount(0),
+    _missCount(0)
+{
+}
+
+GeometryCache::~GeometryCache()
+{
+}
+
+FilePath GeometryCache::getCachePath(const FilePath& sourcePath, bool texcoordVerticalFlip) const
+{
+    const SourceKey key = getSourceKey(sourcePath, texcoordVerticalFlip);
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", (unsigned long long) hashString(key.path + (texcoordVerticalFlip ? "\n1" : "\n0")));
+    return _directory / (sourcePath.getBaseName() + "." + hash + "." + CACHE_EXTENSION);
+}
+
+bool GeometryCache::read(const FilePath& sourcePath, MeshList& meshList, bool texcoordVerticalFlip)
+{
+    MappedFilePtr file = MappedFile::create(getCachePath(sourcePath, texcoordVerticalFlip));
+    if (file)
+    {
+        MeshList cachedMeshes;
+        try
+        {
+            CacheReader reader(file->getData(), file->getSize());
+            reader.readCache(getSourceKey(sourcePath, texcoordVerticalFlip), sourcePath, cachedMeshes);
+            meshList.insert(meshList.end(), cachedMeshes.begin(), cachedMeshes.end());
+            _hitCount++;
+            return true;
+        }
+        catch (Exception&)
+        {
+        }
+    }
+    _missCount++;
+    return false;
+}
+
+bool GeometryCache::write(const FilePath& sourcePath, const MeshList& meshList, bool texcoordVerticalFlip)
+{
+    CacheWriter writer;
+    writer.writeCache(getSourceKey(sourcePath, texcoordVerticalFlip), meshList);
+    const string data = writer.getData();
+
+    if (!_directory.exists())
+    {
+        _directory.createDirectory();
+    }
+
+    // Write to a temporary file and rename it into place, so that concurrent
+    // readers never observe a partially written cache file.
+    const FilePath cachePath = getCachePath(sourcePath, texcoordVerticalFlip);
+    const string tempPath = cachePath.asString() + "." +
+                            std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "." +
+                            std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+    {
+        std::ofstream stream(tempPath, std::ios::out | std::ios::binary);
+        if (!stream.write(data.data(), (std::streamsize) data.size()))
+        {
+            stream.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tempPath.c_str(), cachePath.asString().c_str()) != 0)
+    {
+        // Some platforms do not allow renaming over an existing file.
+        std::remove(cachePath.asString().c_str());
+        if (std::rename(tempPath.c_str(), cachePath.asString().c_str()) != 0)
+        {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+MATERIALX_NAMESPACE_END
@@ -0,0 +1,91 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef MATERIALX_GEOMETRYCACHE_H
+#define MATERIALX_GEOMETRYCACHE_H
+
+/// @file
+/// On-disk cache of loaded geometry
+
+#include <MaterialXRender/Mesh.h>
+
+#include <MaterialXFormat/File.h>
+
+#include <atomic>
+
+MATERIALX_NAMESPACE_BEGIN
+
+class GeometryCache;
+
+/// A shared pointer to a GeometryCache
+using GeometryCachePtr = shared_ptr<GeometryCache>;
+
+/// @class GeometryCache
+/// A cache of loaded geometry, stored as binary files in a directory on disk.
+///
+/// Each cache file holds the meshes loaded from a single source file,
+/// including their streams, partitions and bounds, and is keyed on the
+/// absolute path of the source file and on whether texture coordinates were
+/// flipped.  A cache file is only used while the modification time and size
+/// of its source file are unchanged, and cache files are mapped into memory
+/// when read, so that the cost of restoring a mesh is a single copy of each
+/// of its buffers.
+///
+/// Cache files store data in the native byte order of the machine that wrote
+/// them, and assume that the geometry loaders in use are not reconfigured
+/// between writing and reading.
+class MX_RENDER_API GeometryCache
+{
+  public:
+    GeometryCache(const FilePath& directory);
+    ~GeometryCache();
+
+    /// Create a new geometry cache, storing its files in the given directory.
+    static GeometryCachePtr create(const FilePath& directory)
+    {
+        return std::make_shared<GeometryCache>(directory);
+    }
+
+    /// Return the directory in which cache files are stored.
+    const FilePath& getDirectory() const
+    {
+        return _directory;
+    }
+
+    /// Return the path of the cache file for the given source file.
+    FilePath getCachePath(const FilePath& sourcePath, bool texcoordVerticalFlip = false) const;
+
+    /// Read the cached meshes for the given source file, appending them to
+    /// the given mesh list with their source URI set to the given path.
+    /// Returns false if no cache file matches the current state of the
+    /// source file, or if the cache file is invalid.
+    bool read(const FilePath& sourcePath, MeshList& meshList, bool texcoordVerticalFlip = false);
+
+    /// Write the given meshes to the cache file for the given source file,
+    /// replacing any previous cache file.  Returns false if the cache file
+    /// could not be written.
+    bool write(const FilePath& sourcePath, const MeshList& meshList, bool texcoordVerticalFlip = false);
+
+    /// Return the number of reads that were served from the cache.
+    size_t getHitCount() const
+    {
+        return _hitCount;
+    }
+
+    /// Return the number of reads that found no matching cache file.
+    size_t getMissCount() const
+    {
+        return _missCount;
+    }
+
+  private:
+    FilePath _directory;
+    std::atomic<size_t> _hitCount;
+    std::atomic<size_t> _missCount;
+};
+
+MATERIALX_NAMESPACE_END
+
+#endif
@@ -93,7 +93,15 @@ bool GeometryHandler::loadGeometry(const FilePath& filePath, bool texcoordVertic
         return true;
     }
 
+    // Restore the geometry from the cache if possible.
+    if (_geometryCache && _geometryCache->read(filePath, _meshes, texcoordVerticalFlip))
+    {
+        computeBounds();
+        return true;
+    }
+
     bool loaded = false;
+    size_t meshCount = _meshes.size();
 
     std::pair<GeometryLoaderMap::iterator, GeometryLoaderMap::iterator> range;
     string extension = filePath.getExtension();
@@ -112,6 +120,10 @@ bool GeometryHandler::loadGeometry(const FilePath& filePath, bool texcoordVertic
     // Recompute bounds if load was successful
     if (loaded)
     {
+        if (_geometryCache)
+        {
+            _geometryCache->write(filePath, MeshList(_meshes.begin() + meshCount, _meshes.end()), texcoordVerticalFlip);
+        }
         computeBounds();
     }
 
@@ -10,6 +10,7 @@
 /// Geometry loader interfaces
 
 #include <MaterialXRender/Export.h>
+#include <MaterialXRender/GeometryCache.h>
 #include <MaterialXRender/Mesh.h>
 
 #include <MaterialXFormat/File.h>
@@ -95,6 +96,21 @@ class MX_RENDER_API GeometryHandler
     /// @param texcoordVerticalFlip Flip texture coordinates in V. Default is to not flip.
     bool loadGeometry(const FilePath& filePath, bool texcoordVerticalFlip = false);
 
+    /// Set the geometry cache for this handler.  When a cache is present,
+    /// geometry is restored from the cache where possible, and geometry that
+    /// is loaded from its source is written to the cache.  Defaults to a
+    /// null pointer, which disables caching.
+    void setGeometryCache(GeometryCachePtr cache)
+    {
+        _geometryCache = cache;
+    }
+
+    /// Return the geometry cache for this handler, if any.
+    GeometryCachePtr getGeometryCache() const
+    {
+        return _geometryCache;
+    }
+
     /// Get list of meshes
     const MeshList& getMeshes() const
     {
@@ -128,6 +144,7 @@ class MX_RENDER_API GeometryHandler
 
   protected:
     GeometryLoaderMap _geometryLoaders;
+    GeometryCachePtr _geometryCache;
     MeshList _meshes;
     Vector3 _minimumBounds;
     Vector3 _maximumBounds;
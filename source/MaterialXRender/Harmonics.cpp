@@ -5,7 +5,9 @@
 
 #include <MaterialXRender/Harmonics.h>
 
+#include <functional>
 #include <iostream>
+#include <mutex>
 
 MATERIALX_NAMESPACE_BEGIN
 
@@ -37,12 +39,6 @@ double imageYToTheta(unsigned int y, unsigned int height)
     return PI * (y + 0.5) / height;
 }
 
-Vector3d sphericalToCartesian(double theta, double phi)
-{
-    double r = std::sin(theta);
-    return Vector3d(-r * std::sin(phi), -std::cos(theta), r * std::cos(phi));
-}
-
 double texelSolidAngle(unsigned int y, unsigned int width, unsigned int height)
 {
     // Return the solid angle of a texel within a lat-long environment map.
@@ -82,39 +78,117 @@ Sh3ScalarCoeffs evalDirection(const Vector3d& dir)
     });
 }
 
-} // anonymous namespace
-
-Sh3ColorCoeffs projectEnvironment(ConstImagePtr env, bool irradiance)
+// Sines and cosines of the spherical coordinates of the texel centers
+// within a lat-long environment map, indexed by row and column.
+class SphericalTables
 {
-    Sh3ColorCoeffs shEnv;
+  public:
+    SphericalTables(unsigned int width, unsigned int height) :
+        sinTheta(height),
+        cosTheta(height),
+        sinPhi(width),
+        cosPhi(width)
+    {
+        for (unsigned int y = 0; y < height; y++)
+        {
+            double theta = imageYToTheta(y, height);
+            sinTheta[y] = std::sin(theta);
+            cosTheta[y] = std::cos(theta);
+        }
+        for (unsigned int x = 0; x < width; x++)
+        {
+            double phi = imageXToPhi(x, width);
+            sinPhi[x] = std::sin(phi);
+            cosPhi[x] = std::cos(phi);
+        }
+    }
 
-    for (unsigned int y = 0; y < env->getHeight(); y++)
+    // Return the direction through the given texel center.
+    Vector3d getDirection(unsigned int x, unsigned int y) const
     {
-        double theta = imageYToTheta(y, env->getHeight());
-        double texelWeight = texelSolidAngle(y, env->getWidth(), env->getHeight());
+        double r = sinTheta[y];
+        return Vector3d(-r * sinPhi[x], -cosTheta[y], r * cosPhi[x]);
+    }
 
-        for (unsigned int x = 0; x < env->getWidth(); x++)
-        {
-            // Sample the color at these coordinates.
-            Color4 color = env->getTexelColor(x, y);
+    vector<double> sinTheta;
+    vector<double> cosTheta;
+    vector<double> sinPhi;
+    vector<double> cosPhi;
+};
 
-            // Compute the direction vector.
-            double phi = imageXToPhi(x, env->getWidth());
-            Vector3d dir = sphericalToCartesian(theta, phi);
+// Call the given function for each row in the given range, distributing rows
+// across threads.
+void processRows(unsigned int rowCount, unsigned int threadCount, const std::function<void(unsigned int)>& func)
+{
+    parallelFor(rowCount, threadCount, [&](size_t y, unsigned int)
+    {
+        func((unsigned int) y);
+    });
+}
 
-            // Evaluate the given direction as SH coefficients.
-            Sh3ScalarCoeffs shDir = evalDirection(dir);
+} // anonymous namespace
 
-            // Combine color with texel weight.
-            Color3d weightedColor(color[0] * texelWeight,
-                                  color[1] * texelWeight,
-                                  color[2] * texelWeight);
+Sh3ColorCoeffs projectEnvironment(ConstImagePtr env, bool irradiance, unsigned int threadCount)
+{
+    const unsigned int width = env->getWidth();
+    const unsigned int height = env->getHeight();
+    const SphericalTables tables(width, height);
+
+    // Precompute the products of column sines and cosines that appear in the
+    // basis functions.
+    vector<double> sinCosPhi(width), sinSqPhi(width), cosSqPhi(width);
+    for (unsigned int x = 0; x < width; x++)
+    {
+        sinCosPhi[x] = tables.sinPhi[x] * tables.cosPhi[x];
+        sinSqPhi[x] = tables.sinPhi[x] * tables.sinPhi[x];
+        cosSqPhi[x] = tables.cosPhi[x] * tables.cosPhi[x];
+    }
 
-            // Update coefficients for the influence of this texel.
-            for (size_t i = 0; i < shEnv.NUM_COEFFS; i++)
-            {
-                shEnv[i] += weightedColor * shDir[i];
-            }
+    // Project each row independently.  Within a row, each basis function is
+    // a constant times a function of phi, so the texel colors are reduced to
+    // six sums before the basis functions are applied.
+    vector<Sh3ColorCoeffs> rowCoeffs(height);
+    processRows(height, threadCount, [&](unsigned int y)
+    {
+        Color3d sum, sumSin, sumCos, sumSinCos, sumSinSq, sumCosSq;
+        for (unsigned int x = 0; x < width; x++)
+        {
+            Color4 texel = env->getTexelColor(x, y);
+            Color3d color(texel[0], texel[1], texel[2]);
+            sum += color;
+            sumSin += color * tables.sinPhi[x];
+            sumCos += color * tables.cosPhi[x];
+            sumSinCos += color * sinCosPhi[x];
+            sumSinSq += color * sinSqPhi[x];
+            sumCosSq += color * cosSqPhi[x];
+        }
+
+        // Apply the basis functions of evalDirection, with direction
+        // components x = -sin(theta) * sin(phi), y = -cos(theta) and
+        // z = sin(theta) * cos(phi).
+        const double sinTheta = tables.sinTheta[y];
+        const double cosTheta = tables.cosTheta[y];
+        const double texelWeight = texelSolidAngle(y, width, height);
+        Sh3ColorCoeffs& coeffs = rowCoeffs[y];
+        coeffs[0] = sum * (BASIS_CONSTANT_0 * texelWeight);
+        coeffs[1] = sum * (BASIS_CONSTANT_1 * -cosTheta * texelWeight);
+        coeffs[2] = sumCos * (BASIS_CONSTANT_1 * sinTheta * texelWeight);
+        coeffs[3] = sumSin * (BASIS_CONSTANT_1 * -sinTheta * texelWeight);
+        coeffs[4] = sumSin * (BASIS_CONSTANT_2 * sinTheta * cosTheta * texelWeight);
+        coeffs[5] = sumCos * (BASIS_CONSTANT_2 * -sinTheta * cosTheta * texelWeight);
+        coeffs[6] = (sumCosSq * (3.0 * sinTheta * sinTheta) - sum) * (BASIS_CONSTANT_3 * texelWeight);
+        coeffs[7] = sumSinCos * (BASIS_CONSTANT_2 * -sinTheta * sinTheta * texelWeight);
+        coeffs[8] = (sumSinSq * (sinTheta * sinTheta) - sum * (cosTheta * cosTheta)) * (BASIS_CONSTANT_4 * texelWeight);
+    });
+
+    // Combine rows in a fixed order, so that results are independent of the
+    // thread count.
+    Sh3ColorCoeffs shEnv;
+    for (const Sh3ColorCoeffs& coeffs : rowCoeffs)
+    {
+        for (size_t i = 0; i < shEnv.NUM_COEFFS; i++)
+        {
+            shEnv[i] += coeffs[i];
         }
     }
 
@@ -136,70 +210,68 @@ Sh3ColorCoeffs projectEnvironment(ConstImagePtr env, bool irradiance)
     return shEnv;
 }
 
-ImagePtr normalizeEnvironment(ConstImagePtr env, float envRadiance, float maxTexelRadiance)
+ImagePtr normalizeEnvironment(ConstImagePtr env, float envRadiance, float maxTexelRadiance, unsigned int threadCount)
 {
-    // Compute the radiance of the original environment map.
-    double origEnvRadiance = 0.0;
-    for (unsigned int y = 0; y < env->getHeight(); y++)
+    // Return the color of the given texel, with maximum texel radiance applied.
+    auto getClampedColor = [&](unsigned int x, unsigned int y)
     {
-        double texelWeight = texelSolidAngle(y, env->getWidth(), env->getHeight());
+        Color4 color = env->getTexelColor(x, y);
+        double texelRadiance = Color3d(color[0], color[1], color[2]).dot(LUMA_COEFFS_REC709);
+        if ((float) texelRadiance > maxTexelRadiance)
+        {
+            color *= maxTexelRadiance / (float) texelRadiance;
+        }
+        return color;
+    };
 
+    // Compute the radiance of each row of the original environment map.
+    vector<double> rowRadiance(env->getHeight());
+    processRows(env->getHeight(), threadCount, [&](unsigned int y)
+    {
+        double texelWeight = texelSolidAngle(y, env->getWidth(), env->getHeight());
         for (unsigned int x = 0; x < env->getWidth(); x++)
         {
-            // Sample the color at these coordinates.
-            Color4 color = env->getTexelColor(x, y);
-
-            // Apply maximum texel radiance.
-            double texelRadiance = Color3d(color[0], color[1], color[2]).dot(LUMA_COEFFS_REC709);
-            if ((float) texelRadiance > maxTexelRadiance)
-            {
-                color *= maxTexelRadiance / (float) texelRadiance;
-            }
-
             // Combine color with texel weight.
+            Color4 color = getClampedColor(x, y);
             Color3d weightedColor(color[0] * texelWeight,
                                   color[1] * texelWeight,
                                   color[2] * texelWeight);
 
-            // Add to environment radiance.
-            double texelContribution = weightedColor.dot(LUMA_COEFFS_REC709);
-            origEnvRadiance += texelContribution;
+            // Add to row radiance.
+            rowRadiance[y] += weightedColor.dot(LUMA_COEFFS_REC709);
         }
+    });
+
+    // Combine rows in a fixed order to compute the environment radiance.
+    double origEnvRadiance = 0.0;
+    for (double radiance : rowRadiance)
+    {
+        origEnvRadiance += radiance;
     }
 
     // Generate the normalized map.
     ImagePtr normEnv = Image::create(env->getWidth(), env->getHeight(), env->getChannelCount(), env->getBaseType());
     normEnv->createResourceBuffer();
     float envNormFactor = origEnvRadiance ? (float) (envRadiance / origEnvRadiance) : 1.0f;
-    for (unsigned int y = 0; y < env->getHeight(); y++)
+    processRows(env->getHeight(), threadCount, [&](unsigned int y)
     {
         for (unsigned int x = 0; x < env->getWidth(); x++)
         {
-            // Sample the color at these coordinates.
-            Color4 color = env->getTexelColor(x, y);
-
-            // Apply maximum texel radiance.
-            double texelRadiance = Color3d(color[0], color[1], color[2]).dot(LUMA_COEFFS_REC709);
-            if ((float) texelRadiance > maxTexelRadiance)
-            {
-                color *= maxTexelRadiance / (float) texelRadiance;
-            }
-
             // Store the normalized color.
-            normEnv->setTexelColor(x, y, color * envNormFactor);
+            normEnv->setTexelColor(x, y, getClampedColor(x, y) * envNormFactor);
         }
-    }
+    });
 
     return normEnv;
 }
 
-void computeDominantLight(ConstImagePtr env, Vector3& lightDir, Color3& lightColor)
+void computeDominantLight(ConstImagePtr env, Vector3& lightDir, Color3& lightColor, unsigned int threadCount)
 {
     // Reference:
     //   https://seblagarde.wordpress.com/2011/10/09/dive-in-sh-buffer-idea/
 
     // Project the environment to spherical harmonics.
-    Sh3ColorCoeffs shEnv = projectEnvironment(env);
+    Sh3ColorCoeffs shEnv = projectEnvironment(env, false, threadCount);
 
     // Handle empty environments.
     if (shEnv == Sh3ColorCoeffs())
@@ -232,22 +304,18 @@ void computeDominantLight(ConstImagePtr env, Vector3& lightDir, Color3& lightCol
     lightColor = Color3((float) color[0], (float) color[1], (float) color[2]);
 }
 
-ImagePtr renderEnvironment(const Sh3ColorCoeffs& shEnv, unsigned int width, unsigned int height)
+ImagePtr renderEnvironment(const Sh3ColorCoeffs& shEnv, unsigned int width, unsigned int height, unsigned int threadCount)
 {
     ImagePtr env = Image::create(width, height, 3, Image::BaseType::FLOAT);
     env->createResourceBuffer();
 
-    for (unsigned int y = 0; y < env->getHeight(); y++)
+    const SphericalTables tables(width, height);
+    processRows(height, threadCount, [&](unsigned int y)
     {
-        double theta = imageYToTheta(y, env->getHeight());
-        for (unsigned int x = 0; x < env->getWidth(); x++)
+        for (unsigned int x = 0; x < width; x++)
         {
-            // Compute the direction vector.
-            double phi = imageXToPhi(x, env->getWidth());
-            Vector3d dir = sphericalToCartesian(theta, phi);
-
-            // Evaluate the given direction as SH coefficients.
-            Sh3ScalarCoeffs shDir = evalDirection(dir);
+            // Evaluate the direction of this texel as SH coefficients.
+            Sh3ScalarCoeffs shDir = evalDirection(tables.getDirection(x, y));
 
             // Compute the signal color in this direction.
             Color3d signalColor;
@@ -264,27 +332,33 @@ ImagePtr renderEnvironment(const Sh3ColorCoeffs& shEnv, unsigned int width, unsi
                 1.0f);
             env->setTexelColor(x, y, outputColor);
         }
-    }
+    });
 
     return env;
 }
 
-ImagePtr renderReferenceIrradiance(ConstImagePtr env, unsigned int width, unsigned int height)
+ImagePtr renderReferenceIrradiance(ConstImagePtr env, unsigned int width, unsigned int height, unsigned int threadCount)
 {
     std::cout << "Rendering reference irradiance map..." << std::endl;
     ImagePtr outImage = Image::create(width, height, 3, Image::BaseType::FLOAT);
     outImage->createResourceBuffer();
 
+    const SphericalTables inTables(env->getWidth(), env->getHeight());
+    const SphericalTables outTables(width, height);
+    std::mutex outputMutex;
+
     // Iterate through output texels.
-    for (unsigned int outY = 0; outY < outImage->getHeight(); outY++)
+    processRows(height, threadCount, [&](unsigned int outY)
     {
-        std::cout << "Rendering irradiance map row " << outY << " of " << outImage->getHeight() << "..." << std::endl;
-        double outTheta = imageYToTheta(outY, outImage->getHeight());
-        for (unsigned int outX = 0; outX < outImage->getWidth(); outX++)
+        {
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cout << "Rendering irradiance map row " << outY << " of " << height << "..." << std::endl;
+        }
+        double outTheta = imageYToTheta(outY, height);
+        for (unsigned int outX = 0; outX < width; outX++)
         {
             // Compute the output direction vector.
-            double outPhi = imageXToPhi(outX, outImage->getWidth());
-            Vector3d outDir = sphericalToCartesian(outTheta, outPhi);
+            Vector3d outDir = outTables.getDirection(outX, outY);
 
             // Initialize output texel color.
             Color3d outColor;
@@ -301,12 +375,8 @@ ImagePtr renderReferenceIrradiance(ConstImagePtr env, unsigned int width, unsign
                 double inTexelWeight = texelSolidAngle(inY, env->getWidth(), env->getHeight());
                 for (unsigned int inX = 0; inX < env->getWidth(); inX++)
                 {
-                    // Compute the input direction vector.
-                    double inPhi = imageXToPhi(inX, env->getWidth());
-                    Vector3d inDir = sphericalToCartesian(inTheta, inPhi);
-
                     // Compute the cosine weight.
-                    double cosineWeight = inDir.dot(outDir);
+                    double cosineWeight = inTables.getDirection(inX, inY).dot(outDir);
                     if (cosineWeight <= 0.0)
                     {
                         continue;
@@ -326,7 +396,7 @@ ImagePtr renderReferenceIrradiance(ConstImagePtr env, unsigned int width, unsign
                                                        (float) (outColor[2] / PI),
                                                        1.0f));
         }
-    }
+    });
 
     return outImage;
 }
@@ -66,36 +66,51 @@ using Sh3ColorCoeffs = ShCoeffs<Color3d, 3>;
 /// @param env An environment map in lat-long format.
 /// @param irradiance If true, then the returned signal will be convolved
 ///    by a clamped cosine kernel to generate irradiance.
+/// @param threadCount The number of threads to use. A value of zero selects
+///    the number of hardware threads.  Results are independent of the
+///    thread count.  Defaults to one.
 /// @return The projection of the environment to third-order SH.
-MX_RENDER_API Sh3ColorCoeffs projectEnvironment(ConstImagePtr env, bool irradiance = false);
+MX_RENDER_API Sh3ColorCoeffs projectEnvironment(ConstImagePtr env, bool irradiance = false, unsigned int threadCount = 1);
 
 /// Normalize an environment to the given radiance.
 /// @param env An environment map in lat-long format.
 /// @param envRadiance The radiance to which the environment map should be normalized.
 /// @param maxTexelRadiance The maximum radiance allowed for any individual texel of the map.
+/// @param threadCount The number of threads to use. A value of zero selects
+///    the number of hardware threads.  Defaults to one.
 /// @return A new normalized environment map, in the same format as the original.
-MX_RENDER_API ImagePtr normalizeEnvironment(ConstImagePtr env, float envRadiance, float maxTexelRadiance);
+MX_RENDER_API ImagePtr normalizeEnvironment(ConstImagePtr env, float envRadiance, float maxTexelRadiance,
+                                            unsigned int threadCount = 1);
 
 /// Compute the dominant light direction and color of an environment map.
 /// @param env An environment map in lat-long format.
 /// @param lightDir Returns the dominant light direction of the environment.
 /// @param lightColor Returns the color of the light from the dominant direction.
-MX_RENDER_API void computeDominantLight(ConstImagePtr env, Vector3& lightDir, Color3& lightColor);
+/// @param threadCount The number of threads to use. A value of zero selects
+///    the number of hardware threads.  Defaults to one.
+MX_RENDER_API void computeDominantLight(ConstImagePtr env, Vector3& lightDir, Color3& lightColor,
+                                        unsigned int threadCount = 1);
 
 /// Render the given spherical harmonic signal to an environment map.
 /// @param shEnv The color signal of the environment encoded as third-order SH.
 /// @param width The width of the output environment map.
 /// @param height The height of the output environment map.
+/// @param threadCount The number of threads to use. A value of zero selects
+///    the number of hardware threads.  Defaults to one.
 /// @return An environment map in the lat-long format.
-MX_RENDER_API ImagePtr renderEnvironment(const Sh3ColorCoeffs& shEnv, unsigned int width, unsigned int height);
+MX_RENDER_API ImagePtr renderEnvironment(const Sh3ColorCoeffs& shEnv, unsigned int width, unsigned int height,
+                                         unsigned int threadCount = 1);
 
 /// Render a reference irradiance map from the given environment map,
 /// using brute-force computations for a slow but accurate result.
 /// @param env An environment map in lat-long format.
 /// @param width The width of the output irradiance map.
 /// @param height The height of the output irradiance map.
+/// @param threadCount The number of threads to use. A value of zero selects
+///    the number of hardware threads.  Defaults to one.
 /// @return An irradiance map in the lat-long format.
-MX_RENDER_API ImagePtr renderReferenceIrradiance(ConstImagePtr env, unsigned int width, unsigned int height);
+MX_RENDER_API ImagePtr renderReferenceIrradiance(ConstImagePtr env, unsigned int width, unsigned int height,
+                                                 unsigned int threadCount = 1);
 
 MATERIALX_NAMESPACE_END
 
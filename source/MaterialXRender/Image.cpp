@@ -15,6 +15,225 @@
 
 MATERIALX_NAMESPACE_BEGIN
 
+namespace
+{
+
+// Convert a stored channel value to a floating-point color component.
+template <class T> float channelToFloat(T value)
+{
+    return value / (float) std::numeric_limits<T>::max();
+}
+
+template <> float channelToFloat(float value)
+{
+    return value;
+}
+
+template <> float channelToFloat(Half value)
+{
+    return value;
+}
+
+// Convert a floating-point color component to a stored channel value.
+template <class T> T floatToChannel(float value)
+{
+    return (T) std::round(value * (float) std::numeric_limits<T>::max());
+}
+
+template <> float floatToChannel(float value)
+{
+    return value;
+}
+
+template <> Half floatToChannel(float value)
+{
+    return (Half) value;
+}
+
+// Read a run of texels with the given type and channel count as colors.
+template <class T, unsigned int N> void readTexels(const void* src, unsigned int count, Color4* dest)
+{
+    const T* data = static_cast<const T*>(src);
+    for (unsigned int i = 0; i < count; i++, data += N)
+    {
+        if constexpr (N == 1)
+        {
+            float scalar = channelToFloat(data[0]);
+            dest[i] = Color4(scalar, scalar, scalar, 1.0f);
+        }
+        else if constexpr (N == 2)
+        {
+            dest[i] = Color4(channelToFloat(data[0]), channelToFloat(data[1]), 0.0f, 1.0f);
+        }
+        else if constexpr (N == 3)
+        {
+            dest[i] = Color4(channelToFloat(data[0]), channelToFloat(data[1]), channelToFloat(data[2]), 1.0f);
+        }
+        else
+        {
+            dest[i] = Color4(channelToFloat(data[0]), channelToFloat(data[1]), channelToFloat(data[2]), channelToFloat(data[3]));
+        }
+    }
+}
+
+// Write a run of colors as texels with the given type and channel count,
+// where a count of zero selects the channel count of the image at runtime.
+template <class T, unsigned int N> void writeTexels(const Color4* src, unsigned int count, unsigned int channelCount, void* dest)
+{
+    const unsigned int stride = N ? N : channelCount;
+    const unsigned int writeChannels = std::min(stride, 4u);
+    T* data = static_cast<T*>(dest);
+    for (unsigned int i = 0; i < count; i++, data += stride)
+    {
+        for (unsigned int c = 0; c < writeChannels; c++)
+        {
+            data[c] = floatToChannel<T>(src[i][c]);
+        }
+    }
+}
+
+using TexelReader = void (*)(const void* src, unsigned int count, Color4* dest);
+using TexelWriter = void (*)(const Color4* src, unsigned int count, unsigned int channelCount, void* dest);
+
+template <class T> TexelReader getTypedTexelReader(unsigned int channelCount)
+{
+    switch (channelCount)
+    {
+        case 1: return &readTexels<T, 1>;
+        case 2: return &readTexels<T, 2>;
+        case 3: return &readTexels<T, 3>;
+        case 4: return &readTexels<T, 4>;
+        default: return nullptr;
+    }
+}
+
+template <class T> TexelWriter getTypedTexelWriter(unsigned int channelCount)
+{
+    switch (channelCount)
+    {
+        case 1: return &writeTexels<T, 1>;
+        case 2: return &writeTexels<T, 2>;
+        case 3: return &writeTexels<T, 3>;
+        case 4: return &writeTexels<T, 4>;
+        default: return &writeTexels<T, 0>;
+    }
+}
+
+// Return the texel reader for the given image format, or nullptr if the
+// format is not supported.
+TexelReader getTexelReader(Image::BaseType baseType, unsigned int channelCount)
+{
+    switch (baseType)
+    {
+        case Image::BaseType::UINT8: return getTypedTexelReader<uint8_t>(channelCount);
+        case Image::BaseType::INT8: return getTypedTexelReader<int8_t>(channelCount);
+        case Image::BaseType::UINT16: return getTypedTexelReader<uint16_t>(channelCount);
+        case Image::BaseType::INT16: return getTypedTexelReader<int16_t>(channelCount);
+        case Image::BaseType::HALF: return getTypedTexelReader<Half>(channelCount);
+        case Image::BaseType::FLOAT: return getTypedTexelReader<float>(channelCount);
+        default: return nullptr;
+    }
+}
+
+// Return the texel writer for the given image format, or nullptr if the
+// format is not supported.
+TexelWriter getTexelWriter(Image::BaseType baseType, unsigned int channelCount)
+{
+    if (!channelCount)
+    {
+        return nullptr;
+    }
+    switch (baseType)
+    {
+        case Image::BaseType::UINT8: return getTypedTexelWriter<uint8_t>(channelCount);
+        case Image::BaseType::INT8: return getTypedTexelWriter<int8_t>(channelCount);
+        case Image::BaseType::UINT16: return getTypedTexelWriter<uint16_t>(channelCount);
+        case Image::BaseType::INT16: return getTypedTexelWriter<int16_t>(channelCount);
+        case Image::BaseType::HALF: return getTypedTexelWriter<Half>(channelCount);
+        case Image::BaseType::FLOAT: return getTypedTexelWriter<float>(channelCount);
+        default: return nullptr;
+    }
+}
+
+// Row-wise access to the texels of an image, with the format of the image
+// resolved once rather than per texel.
+class TexelRows
+{
+  public:
+    TexelRows(const Image& image, const string& caller) :
+        _buffer(static_cast<uint8_t*>(image.getResourceBuffer())),
+        _width(image.getWidth()),
+        _channelCount(image.getChannelCount()),
+        _rowStride(image.getRowStride()),
+        _reader(getTexelReader(image.getBaseType(), image.getChannelCount())),
+        _writer(getTexelWriter(image.getBaseType(), image.getChannelCount()))
+    {
+        if (!_buffer && image.getWidth() && image.getHeight())
+        {
+            throw Exception("Invalid resource buffer in " + caller);
+        }
+        if (!_reader || !_writer)
+        {
+            throw Exception("Unsupported image format in " + caller);
+        }
+    }
+
+    // Read the given row of the image as colors.
+    void read(unsigned int y, Color4* dest) const
+    {
+        _reader(_buffer + (size_t) y * _rowStride, _width, dest);
+    }
+
+    // Write the given colors to a row of the image.
+    void write(unsigned int y, const Color4* src) const
+    {
+        _writer(src, _width, _channelCount, _buffer + (size_t) y * _rowStride);
+    }
+
+  private:
+    uint8_t* _buffer;
+    unsigned int _width;
+    unsigned int _channelCount;
+    size_t _rowStride;
+    TexelReader _reader;
+    TexelWriter _writer;
+};
+
+// A sliding window over the rows of an image, for filters that read a
+// fixed number of consecutive rows for each row they write.
+class RowWindow
+{
+  public:
+    RowWindow(const TexelRows& rows, unsigned int width, unsigned int size) :
+        _rows(rows),
+        _width(width),
+        _buffer((size_t) width * size),
+        _rowIndices(size, -1)
+    {
+    }
+
+    // Return the given row as colors, reading it only if it has left the window.
+    const Color4* getRow(unsigned int y)
+    {
+        size_t slot = y % _rowIndices.size();
+        Color4* row = _buffer.data() + slot * _width;
+        if (_rowIndices[slot] != (int) y)
+        {
+            _rows.read(y, row);
+            _rowIndices[slot] = (int) y;
+        }
+        return row;
+    }
+
+  private:
+    const TexelRows& _rows;
+    unsigned int _width;
+    vector<Color4> _buffer;
+    vector<int> _rowIndices;
+};
+
+} // anonymous namespace
+
 //
 // Global functions
 //
@@ -140,60 +359,14 @@ void Image::setTexelColor(unsigned int x, unsigned int y, const Color4& color)
     {
         throw Exception("Invalid resource buffer in setTexelColor");
     }
-
-    unsigned int writeChannels = std::min(_channelCount, (unsigned int) 4);
-    if (_baseType == BaseType::FLOAT)
-    {
-        float* data = static_cast<float*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        for (unsigned int c = 0; c < writeChannels; c++)
-        {
-            data[c] = color[c];
-        }
-    }
-    else if (_baseType == BaseType::HALF)
-    {
-        Half* data = static_cast<Half*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        for (unsigned int c = 0; c < writeChannels; c++)
-        {
-            data[c] = (Half) color[c];
-        }
-    }
-    else if (_baseType == BaseType::UINT16)
-    {
-        uint16_t* data = static_cast<uint16_t*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        for (unsigned int c = 0; c < writeChannels; c++)
-        {
-            data[c] = (uint16_t) std::round(color[c] * (float) std::numeric_limits<uint16_t>::max());
-        }
-    }
-    else if (_baseType == BaseType::INT16)
-    {
-        int16_t* data = static_cast<int16_t*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        for (unsigned int c = 0; c < writeChannels; c++)
-        {
-            data[c] = (int16_t) std::round(color[c] * (float) std::numeric_limits<int16_t>::max());
-        }
-    }
-    else if (_baseType == BaseType::UINT8)
-    {
-        uint8_t* data = static_cast<uint8_t*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        for (unsigned int c = 0; c < writeChannels; c++)
-        {
-            data[c] = (uint8_t) std::round(color[c] * (float) std::numeric_limits<uint8_t>::max());
-        }
-    }
-    else if (_baseType == BaseType::INT8)
-    {
-        int8_t* data = static_cast<int8_t*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        for (unsigned int c = 0; c < writeChannels; c++)
-        {
-            data[c] = (int8_t) std::round(color[c] * (float) std::numeric_limits<int8_t>::max());
-        }
-    }
-    else
+    TexelWriter writer = getTexelWriter(_baseType, _channelCount);
+    if (!writer)
     {
-        throw Exception("Unsupported base type in setTexelColor");
+        throw Exception("Unsupported image format in setTexelColor");
     }
+
+    size_t offset = ((size_t) y * _width + x) * _channelCount * getBaseStride();
+    writer(&color, 1, _channelCount, static_cast<uint8_t*>(_resourceBuffer) + offset);
 }
 
 Color4 Image::getTexelColor(unsigned int x, unsigned int y) const
@@ -206,173 +379,30 @@ Color4 Image::getTexelColor(unsigned int x, unsigned int y) const
     {
         throw Exception("Invalid resource buffer in getTexelColor");
     }
-
-    if (_baseType == BaseType::FLOAT)
+    TexelReader reader = getTexelReader(_baseType, _channelCount);
+    if (!reader)
     {
-        float* data = static_cast<float*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        if (_channelCount == 4)
-        {
-            return Color4(data[0], data[1], data[2], data[3]);
-        }
-        else if (_channelCount == 3)
-        {
-            return Color4(data[0], data[1], data[2], 1.0f);
-        }
-        else if (_channelCount == 2)
-        {
-            return Color4(data[0], data[1], 0.0f, 1.0f);
-        }
-        else if (_channelCount == 1)
-        {
-            return Color4(data[0], data[0], data[0], 1.0f);
-        }
-        else
-        {
-            throw Exception("Unsupported channel count in getTexelColor");
-        }
-    }
-    else if (_baseType == BaseType::HALF)
-    {
-        Half* data = static_cast<Half*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        if (_channelCount == 4)
-        {
-            return Color4(data[0], data[1], data[2], data[3]);
-        }
-        else if (_channelCount == 3)
-        {
-            return Color4(data[0], data[1], data[2], 1.0f);
-        }
-        else if (_channelCount == 2)
-        {
-            return Color4(data[0], data[1], 0.0f, 1.0f);
-        }
-        else if (_channelCount == 1)
-        {
-            return Color4(data[0], data[0], data[0], 1.0f);
-        }
-        else
-        {
-            throw Exception("Unsupported channel count in getTexelColor");
-        }
-    }
-    else if (_baseType == BaseType::UINT16)
-    {
-        uint16_t* data = static_cast<uint16_t*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        const float MAX_VALUE = (float) std::numeric_limits<uint16_t>::max();
-        if (_channelCount == 4)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, data[2] / MAX_VALUE, data[3] / MAX_VALUE);
-        }
-        else if (_channelCount == 3)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, data[2] / MAX_VALUE, 1.0f);
-        }
-        else if (_channelCount == 2)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, 0.0f, 1.0f);
-        }
-        else if (_channelCount == 1)
-        {
-            float scalar = data[0] / MAX_VALUE;
-            return Color4(scalar, scalar, scalar, 1.0f);
-        }
-        else
-        {
-            throw Exception("Unsupported channel count in getTexelColor");
-        }
-    }
-    else if (_baseType == BaseType::INT16)
-    {
-        int16_t* data = static_cast<int16_t*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        const float MAX_VALUE = (float) std::numeric_limits<int16_t>::max();
-        if (_channelCount == 4)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, data[2] / MAX_VALUE, data[3] / MAX_VALUE);
-        }
-        else if (_channelCount == 3)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, data[2] / MAX_VALUE, 1.0f);
-        }
-        else if (_channelCount == 2)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, 0.0f, 1.0f);
-        }
-        else if (_channelCount == 1)
-        {
-            float scalar = data[0] / MAX_VALUE;
-            return Color4(scalar, scalar, scalar, 1.0f);
-        }
-        else
-        {
-            throw Exception("Unsupported channel count in getTexelColor");
-        }
-    }
-    else if (_baseType == BaseType::UINT8)
-    {
-        uint8_t* data = static_cast<uint8_t*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        const float MAX_VALUE = (float) std::numeric_limits<uint8_t>::max();
-        if (_channelCount == 4)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, data[2] / MAX_VALUE, data[3] / MAX_VALUE);
-        }
-        else if (_channelCount == 3)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, data[2] / MAX_VALUE, 1.0f);
-        }
-        else if (_channelCount == 2)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, 0.0f, 1.0f);
-        }
-        else if (_channelCount == 1)
-        {
-            float scalar = data[0] / MAX_VALUE;
-            return Color4(scalar, scalar, scalar, 1.0f);
-        }
-        else
-        {
-            throw Exception("Unsupported channel count in getTexelColor");
-        }
-    }
-    else if (_baseType == BaseType::INT8)
-    {
-        int8_t* data = static_cast<int8_t*>(_resourceBuffer) + (y * _width + x) * _channelCount;
-        const float MAX_VALUE = (float) std::numeric_limits<int8_t>::max();
-        if (_channelCount == 4)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, data[2] / MAX_VALUE, data[3] / MAX_VALUE);
-        }
-        else if (_channelCount == 3)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, data[2] / MAX_VALUE, 1.0f);
-        }
-        else if (_channelCount == 2)
-        {
-            return Color4(data[0] / MAX_VALUE, data[1] / MAX_VALUE, 0.0f, 1.0f);
-        }
-        else if (_channelCount == 1)
-        {
-            float scalar = data[0] / MAX_VALUE;
-            return Color4(scalar, scalar, scalar, 1.0f);
-        }
-        else
-        {
-            throw Exception("Unsupported channel count in getTexelColor");
-        }
-    }
-    else
-    {
-        throw Exception("Unsupported base type in getTexelColor");
+        throw Exception("Unsupported image format in getTexelColor");
     }
+
+    Color4 color;
+    size_t offset = ((size_t) y * _width + x) * _channelCount * getBaseStride();
+    reader(static_cast<const uint8_t*>(_resourceBuffer) + offset, 1, &color);
+    return color;
 }
 
 Color4 Image::getAverageColor()
 {
+    TexelRows rows(*this, "getAverageColor");
+    vector<Color4> row(getWidth());
+
     Color4 averageColor;
     for (unsigned int y = 0; y < getHeight(); y++)
     {
-        for (unsigned int x = 0; x < getWidth(); x++)
+        rows.read(y, row.data());
+        for (const Color4& color : row)
         {
-            averageColor += getTexelColor(x, y);
+            averageColor += color;
         }
     }
     unsigned int sampleCount = getWidth() * getHeight();
@@ -383,15 +413,14 @@ Color4 Image::getAverageColor()
 bool Image::isUniformColor(Color4* uniformColor)
 {
     Color4 refColor = getTexelColor(0, 0);
+    TexelRows rows(*this, "isUniformColor");
+    vector<Color4> row(getWidth());
     for (unsigned int y = 0; y < getHeight(); y++)
     {
-        for (unsigned int x = 0; x < getWidth(); x++)
+        rows.read(y, row.data());
+        for (unsigned int x = y ? 0 : 1; x < getWidth(); x++)
         {
-            if (!x && !y)
-            {
-                continue;
-            }
-            if (getTexelColor(x, y) != refColor)
+            if (row[x] != refColor)
             {
                 return false;
             }
@@ -406,42 +435,53 @@ bool Image::isUniformColor(Color4* uniformColor)
 
 void Image::setUniformColor(const Color4& color)
 {
-    for (unsigned int y = 0; y < getHeight(); y++)
+    if (!getWidth() || !getHeight())
     {
-        for (unsigned int x = 0; x < getWidth(); x++)
-        {
-            setTexelColor(x, y, color);
-        }
+        return;
+    }
+
+    // Write the first row, then replicate it to the remaining rows.
+    TexelRows rows(*this, "setUniformColor");
+    vector<Color4> row(getWidth(), color);
+    rows.write(0, row.data());
+    uint8_t* data = static_cast<uint8_t*>(_resourceBuffer);
+    for (unsigned int y = 1; y < getHeight(); y++)
+    {
+        memcpy(data + (size_t) y * getRowStride(), data, getRowStride());
     }
 }
 
 void Image::applyMatrixTransform(const Matrix33& mat)
 {
+    TexelRows rows(*this, "applyMatrixTransform");
+    vector<Color4> row(getWidth());
     for (unsigned int y = 0; y < getHeight(); y++)
     {
-        for (unsigned int x = 0; x < getWidth(); x++)
+        rows.read(y, row.data());
+        for (Color4& color : row)
         {
-            Color4 color = getTexelColor(x, y);
             Vector3 vec(color[0], color[1], color[2]);
             vec = mat.multiply(vec);
-            setTexelColor(x, y, Color4(vec[0], vec[1], vec[2], color[3]));
+            color = Color4(vec[0], vec[1], vec[2], color[3]);
         }
+        rows.write(y, row.data());
     }
 }
 
 void Image::applyGammaTransform(float gamma)
 {
+    TexelRows rows(*this, "applyGammaTransform");
+    vector<Color4> row(getWidth());
     for (unsigned int y = 0; y < getHeight(); y++)
     {
-        for (unsigned int x = 0; x < getWidth(); x++)
+        rows.read(y, row.data());
+        for (Color4& color : row)
         {
-            Color4 color = getTexelColor(x, y);
-            Vector3 vec(color[0], color[1], color[2]);
-            vec[0] = std::pow(std::max(vec[0], 0.0f), gamma);
-            vec[1] = std::pow(std::max(vec[1], 0.0f), gamma);
-            vec[2] = std::pow(std::max(vec[2], 0.0f), gamma);
-            setTexelColor(x, y, Color4(vec[0], vec[1], vec[2], color[3]));
+            color[0] = std::pow(std::max(color[0], 0.0f), gamma);
+            color[1] = std::pow(std::max(color[1], 0.0f), gamma);
+            color[2] = std::pow(std::max(color[2], 0.0f), gamma);
         }
+        rows.write(y, row.data());
     }
 }
 
@@ -450,12 +490,13 @@ ImagePtr Image::copy(unsigned int channelCount, BaseType baseType) const
     ImagePtr newImage = Image::create(getWidth(), getHeight(), channelCount, baseType);
     newImage->createResourceBuffer();
 
-    for (int y = 0; y < (int) getHeight(); y++)
+    TexelRows srcRows(*this, "copy");
+    TexelRows destRows(*newImage, "copy");
+    vector<Color4> row(getWidth());
+    for (unsigned int y = 0; y < getHeight(); y++)
     {
-        for (int x = 0; x < (int) getWidth(); x++)
-        {
-            newImage->setTexelColor(x, y, getTexelColor(x, y));
-        }
+        srcRows.read(y, row.data());
+        destRows.write(y, row.data());
     }
 
     return newImage;
@@ -466,23 +507,33 @@ ImagePtr Image::applyBoxBlur()
     ImagePtr blurImage = Image::create(getWidth(), getHeight(), getChannelCount(), getBaseType());
     blurImage->createResourceBuffer();
 
+    TexelRows srcRows(*this, "applyBoxBlur");
+    TexelRows destRows(*blurImage, "applyBoxBlur");
+    RowWindow window(srcRows, getWidth(), 3);
+    vector<Color4> blurRow(getWidth());
     for (int y = 0; y < (int) getHeight(); y++)
     {
+        const Color4* rows[3];
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            int sy = std::min(std::max(y + dy, 0), (int) getHeight() - 1);
+            rows[dy + 1] = window.getRow(sy);
+        }
         for (int x = 0; x < (int) getWidth(); x++)
         {
             Color4 blurColor;
-            for (int dy = -1; dy <= 1; dy++)
+            for (const Color4* row : rows)
             {
-                int sy = std::min(std::max(y + dy, 0), (int) getHeight() - 1);
                 for (int dx = -1; dx <= 1; dx++)
                 {
                     int sx = std::min(std::max(x + dx, 0), (int) getWidth() - 1);
-                    blurColor += getTexelColor(sx, sy);
+                    blurColor += row[sx];
                 }
             }
             blurColor /= 9.0f;
-            blurImage->setTexelColor(x, y, blurColor);
+            blurRow[x] = blurColor;
         }
+        destRows.write(y, blurRow.data());
     }
 
     return blurImage;
@@ -495,23 +546,38 @@ ImagePtr Image::applyGaussianBlur()
     blurImage1->createResourceBuffer();
     blurImage2->createResourceBuffer();
 
+    TexelRows srcRows(*this, "applyGaussianBlur");
+    TexelRows blurRows1(*blurImage1, "applyGaussianBlur");
+    TexelRows blurRows2(*blurImage2, "applyGaussianBlur");
+    vector<Color4> row(getWidth());
+    vector<Color4> blurRow(getWidth());
+
+    // Apply the vertical pass of the separable kernel.
+    RowWindow window(srcRows, getWidth(), (unsigned int) GAUSSIAN_KERNEL_7.size());
     for (int y = 0; y < (int) getHeight(); y++)
     {
+        const Color4* rows[7];
+        for (int dy = -3; dy <= 3; dy++)
+        {
+            int sy = std::min(std::max(y + dy, 0), (int) getHeight() - 1);
+            rows[dy + 3] = window.getRow(sy);
+        }
         for (int x = 0; x < (int) getWidth(); x++)
         {
             Color4 blurColor;
-            unsigned int weightIndex = 0;
-            for (int dy = -3; dy <= 3; dy++, weightIndex++)
+            for (unsigned int weightIndex = 0; weightIndex < 7; weightIndex++)
             {
-                int sy = std::min(std::max(y + dy, 0), (int) getHeight() - 1);
-                blurColor += getTexelColor(x, sy) * GAUSSIAN_KERNEL_7[weightIndex];
+                blurColor += rows[weightIndex][x] * GAUSSIAN_KERNEL_7[weightIndex];
             }
-            blurImage1->setTexelColor(x, y, blurColor);
+            blurRow[x] = blurColor;
         }
+        blurRows1.write(y, blurRow.data());
     }
 
+    // Apply the horizontal pass of the separable kernel.
     for (int y = 0; y < (int) getHeight(); y++)
     {
+        blurRows1.read(y, row.data());
         for (int x = 0; x < (int) getWidth(); x++)
         {
             Color4 blurColor;
@@ -519,10 +585,11 @@ ImagePtr Image::applyGaussianBlur()
             for (int dx = -3; dx <= 3; dx++, weightIndex++)
             {
                 int sx = std::min(std::max(x + dx, 0), (int) getWidth() - 1);
-                blurColor += blurImage1->getTexelColor(sx, y) * GAUSSIAN_KERNEL_7[weightIndex];
+                blurColor += row[sx] * GAUSSIAN_KERNEL_7[weightIndex];
             }
-            blurImage2->setTexelColor(x, y, blurColor);
+            blurRow[x] = blurColor;
         }
+        blurRows2.write(y, blurRow.data());
     }
 
     return blurImage2;
@@ -535,23 +602,33 @@ ImagePtr Image::applyBoxDownsample(unsigned int factor)
     ImagePtr sampleImage = Image::create(std::max(getWidth() / factor, 1u), std::max(getHeight() / factor, 1u), getChannelCount(), getBaseType());
     sampleImage->createResourceBuffer();
 
+    TexelRows srcRows(*this, "applyBoxDownsample");
+    TexelRows destRows(*sampleImage, "applyBoxDownsample");
+    RowWindow window(srcRows, getWidth(), factor);
+    vector<const Color4*> rows(factor);
+    vector<Color4> sampleRow(sampleImage->getWidth());
     for (int y = 0; y < (int) sampleImage->getHeight(); y++)
     {
+        for (int dy = 0; dy < (int) factor; dy++)
+        {
+            int sy = std::min(std::max(y * (int) factor + dy, 0), (int) getHeight() - 1);
+            rows[dy] = window.getRow(sy);
+        }
         for (int x = 0; x < (int) sampleImage->getWidth(); x++)
         {
             Color4 sampleColor;
-            for (int dy = 0; dy < (int) factor; dy++)
+            for (const Color4* row : rows)
             {
-                int sy = std::min(std::max(y * (int) factor + dy, 0), (int) getHeight() - 1);
                 for (int dx = 0; dx < (int) factor; dx++)
                 {
                     int sx = std::min(std::max(x * (int) factor + dx, 0), (int) getWidth() - 1);
-                    sampleColor += getTexelColor(sx, sy);
+                    sampleColor += row[sx];
                 }
             }
             sampleColor /= (float) (factor * factor);
-            sampleImage->setTexelColor(x, y, sampleColor);
+            sampleRow[x] = sampleColor;
         }
+        destRows.write(y, sampleRow.data());
     }
 
     return sampleImage;
@@ -564,11 +641,18 @@ ImagePair Image::splitByLuminance(float luminance)
     underflowImage->createResourceBuffer();
     overflowImage->createResourceBuffer();
 
+    TexelRows srcRows(*this, "splitByLuminance");
+    TexelRows underflowRows(*underflowImage, "splitByLuminance");
+    TexelRows overflowRows(*overflowImage, "splitByLuminance");
+    vector<Color4> row(getWidth());
+    vector<Color4> underflowRow(getWidth());
+    vector<Color4> overflowRow(getWidth());
     for (unsigned int y = 0; y < getHeight(); y++)
     {
+        srcRows.read(y, row.data());
         for (unsigned int x = 0; x < getWidth(); x++)
         {
-            Color4 envColor = getTexelColor(x, y);
+            const Color4& envColor = row[x];
             Color4 underflowColor(
                 std::min(envColor[0], luminance),
                 std::min(envColor[1], luminance),
@@ -577,9 +661,11 @@ ImagePair Image::splitByLuminance(float luminance)
                 std::max(envColor[0] - underflowColor[0], 0.0f),
                 std::max(envColor[1] - underflowColor[1], 0.0f),
                 std::max(envColor[2] - underflowColor[2], 0.0f), 1.0f);
-            underflowImage->setTexelColor(x, y, underflowColor);
-            overflowImage->setTexelColor(x, y, overflowColor);
+            underflowRow[x] = underflowColor;
+            overflowRow[x] = overflowColor;
         }
+        underflowRows.write(y, underflowRow.data());
+        overflowRows.write(y, overflowRow.data());
     }
 
     return std::make_pair(underflowImage, overflowImage);
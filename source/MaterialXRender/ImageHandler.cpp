@@ -52,7 +52,8 @@ ImagePtr ImageLoader::loadImage(const FilePath&)
 // ImageHandler methods
 //
 
-ImageHandler::ImageHandler(ImageLoaderPtr imageLoader)
+ImageHandler::ImageHandler(ImageLoaderPtr imageLoader) :
+    _imageCacheBudget(0)
 {
     addLoader(imageLoader);
     _zeroImage = createUniformImage(2, 2, 4, Image::BaseType::UINT8, Color4(0.0f));
@@ -128,14 +129,25 @@ ImagePtr ImageHandler::acquireImage(const FilePath& filePath, const Color4& defa
     ImagePtr cachedImage = getCachedImage(resolvedFilePath);
     if (cachedImage)
     {
+        _imageCacheStats.hitCount++;
+        return cachedImage;
+    }
+
+    // Return an image that was cached under another path to the same file.
+    const string& key = getImageCacheKey(resolvedFilePath);
+    cachedImage = getCachedImage(key);
+    if (cachedImage)
+    {
+        _imageCacheStats.hitCount++;
         return cachedImage;
     }
 
     // Load and cache the requested image.
-    ImagePtr image = loadImage(_searchPath.find(resolvedFilePath));
+    _imageCacheStats.missCount++;
+    ImagePtr image = loadImage(key);
     if (image)
     {
-        cacheImage(resolvedFilePath, image);
+        cacheImage(key, image);
         return image;
     }
 
@@ -143,7 +155,7 @@ ImagePtr ImageHandler::acquireImage(const FilePath& filePath, const Color4& defa
     // TODO: This step assumes that the missing image and its default color are in the same
     //       color space, which is not always the case.
     ImagePtr defaultImage = createUniformImage(1, 1, 4, Image::BaseType::UINT8, defaultColor);
-    cacheImage(resolvedFilePath, defaultImage);
+    cacheImage(key, defaultImage);
     return defaultImage;
 }
 
@@ -236,29 +248,106 @@ ImagePtr ImageHandler::loadImage(const FilePath& filePath)
     return nullptr;
 }
 
+void ImageHandler::clearImageCache()
+{
+    releaseRenderResources();
+    _imageCache.clear();
+    _imageCacheEntries.clear();
+    _imageCacheOrder.clear();
+    _imageCacheStats.imageCount = 0;
+    _imageCacheStats.byteCount = 0;
+}
+
+void ImageHandler::setImageCacheBudget(size_t byteCount)
+{
+    _imageCacheBudget = byteCount;
+    evictImages();
+}
+
 void ImageHandler::cacheImage(const string& filePath, ImagePtr image)
 {
+    auto it = _imageCacheEntries.find(filePath);
+    if (it != _imageCacheEntries.end())
+    {
+        _imageCacheStats.byteCount -= it->second.byteCount;
+        _imageCacheOrder.erase(it->second.lruPosition);
+        _imageCacheEntries.erase(it);
+    }
+
+    ImageCacheEntry entry;
+    entry.lruPosition = _imageCacheOrder.insert(_imageCacheOrder.begin(), filePath);
+    entry.byteCount = (size_t) image->getRowStride() * image->getHeight();
+    _imageCacheEntries[filePath] = entry;
     _imageCache[filePath] = image;
+    _imageCacheStats.imageCount = _imageCache.size();
+    _imageCacheStats.byteCount += entry.byteCount;
+
+    evictImages();
 }
 
 ImagePtr ImageHandler::getCachedImage(const FilePath& filePath)
 {
-    if (_imageCache.count(filePath))
+    string key = filePath.asString();
+    auto keyIt = _imageCacheKeys.find(key);
+    if (keyIt != _imageCacheKeys.end())
     {
-        return _imageCache[filePath];
+        key = keyIt->second;
     }
-    if (!filePath.isAbsolute())
+
+    auto it = _imageCache.find(key);
+    if (it == _imageCache.end())
+    {
+        return nullptr;
+    }
+
+    // Mark the image as most recently used.
+    auto entryIt = _imageCacheEntries.find(key);
+    if (entryIt != _imageCacheEntries.end())
     {
-        for (const FilePath& path : _searchPath)
+        _imageCacheOrder.splice(_imageCacheOrder.begin(), _imageCacheOrder, entryIt->second.lruPosition);
+    }
+    return it->second;
+}
+
+const string& ImageHandler::getImageCacheKey(const FilePath& filePath)
+{
+    const string path = filePath.asString();
+    auto it = _imageCacheKeys.find(path);
+    if (it == _imageCacheKeys.end())
+    {
+        it = _imageCacheKeys.emplace(path, _searchPath.find(filePath).getNormalized().asString()).first;
+    }
+    return it->second;
+}
+
+void ImageHandler::evictImages()
+{
+    if (!_imageCacheBudget)
+    {
+        return;
+    }
+
+    // Visit images from least to most recently used, skipping images that
+    // are referenced outside of the cache.
+    auto it = _imageCacheOrder.end();
+    while (_imageCacheStats.byteCount > _imageCacheBudget && it != _imageCacheOrder.begin())
+    {
+        --it;
+        auto imageIt = _imageCache.find(*it);
+        if (imageIt->second.use_count() > 1)
         {
-            FilePath combined = path / filePath;
-            if (_imageCache.count(combined))
-            {
-                return _imageCache[combined];
-            }
+            continue;
         }
+
+        releaseRenderResources(imageIt->second);
+        _imageCache.erase(imageIt);
+        auto entryIt = _imageCacheEntries.find(*it);
+        _imageCacheStats.byteCount -= entryIt->second.byteCount;
+        _imageCacheEntries.erase(entryIt);
+        it = _imageCacheOrder.erase(it);
+        _imageCacheStats.evictionCount++;
     }
-    return nullptr;
+    _imageCacheStats.imageCount = _imageCache.size();
 }
 
 //
@@ -16,6 +16,8 @@
 
 #include <MaterialXCore/Document.h>
 
+#include <list>
+
 MATERIALX_NAMESPACE_BEGIN
 
 extern MX_RENDER_API const string IMAGE_PROPERTY_SEPARATOR;
@@ -155,6 +157,26 @@ class MX_RENDER_API ImageLoader
     StringSet _extensions;
 };
 
+/// @struct ImageCacheStats
+/// Statistics describing the image cache of an ImageHandler.
+struct MX_RENDER_API ImageCacheStats
+{
+    /// The number of images currently held in the cache.
+    size_t imageCount = 0;
+
+    /// The total size in bytes of the images held in the cache.
+    size_t byteCount = 0;
+
+    /// The number of image requests that were served from the cache.
+    size_t hitCount = 0;
+
+    /// The number of image requests that required an image to be loaded.
+    size_t missCount = 0;
+
+    /// The number of images that were evicted to remain within the budget.
+    size_t evictionCount = 0;
+};
+
 /// @class ImageHandler
 /// Base image handler class. Keeps track of images which are loaded from
 /// disk via supplied ImageLoader. Derived classes are responsible for
@@ -209,6 +231,7 @@ class MX_RENDER_API ImageHandler
     void setSearchPath(const FileSearchPath& path)
     {
         _searchPath = path;
+        _imageCacheKeys.clear();
     }
 
     /// Return the image search path.
@@ -238,10 +261,26 @@ class MX_RENDER_API ImageHandler
 
     /// Clear the contents of the image cache, first releasing any render
     /// resources associated with cached images.
-    void clearImageCache()
+    void clearImageCache();
+
+    /// Set the memory budget of the image cache in bytes.  When the total
+    /// size of cached images exceeds the budget, least recently used images
+    /// are evicted from the cache and their render resources are released.
+    /// Images that are referenced outside of the cache, such as the images
+    /// bound by a material, are never evicted.  A budget of zero, which is
+    /// the default, disables eviction.
+    void setImageCacheBudget(size_t byteCount);
+
+    /// Return the memory budget of the image cache in bytes.
+    size_t getImageCacheBudget() const
     {
-        releaseRenderResources();
-        _imageCache.clear();
+        return _imageCacheBudget;
+    }
+
+    /// Return statistics describing the image cache.
+    const ImageCacheStats& getImageCacheStats() const
+    {
+        return _imageCacheStats;
     }
 
     /// Return a fallback image with zeroes in all channels.
@@ -261,16 +300,35 @@ class MX_RENDER_API ImageHandler
     // Load an image from the file system.
     ImagePtr loadImage(const FilePath& filePath);
 
-    // Add an image to the cache.
+    // Add an image to the cache, evicting least recently used images as
+    // needed to remain within the cache budget.
     void cacheImage(const string& filePath, ImagePtr image);
 
     // Return the cached image, if found; otherwise return an empty
     // shared pointer.
     ImagePtr getCachedImage(const FilePath& filePath);
 
+    // Return the canonical cache key for the given file path, resolving it
+    // against the search path.
+    const string& getImageCacheKey(const FilePath& filePath);
+
+    // Evict least recently used images until the cache is within its budget.
+    void evictImages();
+
   protected:
+    struct ImageCacheEntry
+    {
+        std::list<string>::iterator lruPosition;
+        size_t byteCount;
+    };
+
     ImageLoaderMap _imageLoaders;
     ImageMap _imageCache;
+    std::unordered_map<string, ImageCacheEntry> _imageCacheEntries;
+    std::list<string> _imageCacheOrder;
+    StringMap _imageCacheKeys;
+    size_t _imageCacheBudget;
+    ImageCacheStats _imageCacheStats;
     FileSearchPath _searchPath;
     StringResolverPtr _resolver;
     ImagePtr _zeroImage;
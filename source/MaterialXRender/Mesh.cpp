@@ -5,6 +5,9 @@
 
 #include <MaterialXRender/Mesh.h>
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <limits>
 #include <map>
 
@@ -24,8 +27,243 @@ namespace
 const float MAX_FLOAT = std::numeric_limits<float>::max();
 const size_t FACE_VERTEX_COUNT = 3;
 
+// The minimum number of faces or vertices assigned to each thread.
+const size_t MIN_RANGE_SIZE = 4096;
+
+// Divide the given number of items into contiguous ranges, one per thread,
+// and call the given function with the bounds of each range.  A thread count
+// of zero selects the number of hardware threads.
+size_t getRangeCount(size_t count, unsigned int threadCount)
+{
+    return getParallelWorkerCount(count / MIN_RANGE_SIZE, threadCount);
+}
+
+void processRanges(size_t count, unsigned int threadCount, const std::function<void(size_t, size_t)>& func)
+{
+    size_t rangeCount = getRangeCount(count, threadCount);
+    parallelFor(rangeCount, (unsigned int) rangeCount, [&](size_t range, unsigned int)
+    {
+        func(count * range / rangeCount, count * (range + 1) / rangeCount);
+    });
+}
+
+// The faces of all partitions of a mesh, indexed in partition order.
+class FaceList
+{
+  public:
+    explicit FaceList(const Mesh& mesh) :
+        _faceCount(0)
+    {
+        for (size_t i = 0; i < mesh.getPartitionCount(); i++)
+        {
+            MeshPartitionPtr part = mesh.getPartition(i);
+            _partitions.push_back(part);
+            _offsets.push_back(_faceCount);
+            _faceCount += part->getFaceCount();
+        }
+    }
+
+    size_t getFaceCount() const
+    {
+        return _faceCount;
+    }
+
+    // Call the given function with the index and vertex indices of each face
+    // in the given range.
+    template <class F> void forEachFace(size_t begin, size_t end, F func) const
+    {
+        for (size_t i = 0; i < _partitions.size(); i++)
+        {
+            size_t partBegin = _offsets[i];
+            size_t partEnd = partBegin + _partitions[i]->getFaceCount();
+            const uint32_t* indices = _partitions[i]->getIndices().data();
+            for (size_t face = std::max(begin, partBegin); face < std::min(end, partEnd); face++)
+            {
+                func(face, indices + (face - partBegin) * FACE_VERTEX_COUNT);
+            }
+        }
+    }
+
+  private:
+    vector<MeshPartitionPtr> _partitions;
+    vector<size_t> _offsets;
+    size_t _faceCount;
+};
+
+// Compute a value for each face with the given function, and pass it to the
+// given function for each vertex of the face, in face order.  When more than
+// one thread is used, face values are computed in parallel, and then each
+// thread applies face values to its own range of vertices, visiting the
+// faces of each vertex in face order, so that results match serial
+// processing without synchronization between threads.
+template <class C, class A> void processFaceValues(const FaceList& faces, size_t vertexCount, unsigned int threadCount,
+                                                   C computeValue, A applyValue)
+{
+    if (getRangeCount(faces.getFaceCount(), threadCount) <= 1)
+    {
+        faces.forEachFace(0, faces.getFaceCount(), [&](size_t, const uint32_t* indices)
+        {
+            Vector3 value = computeValue(indices);
+            for (size_t i = 0; i < FACE_VERTEX_COUNT; i++)
+            {
+                applyValue(indices[i], value);
+            }
+        });
+        return;
+    }
+
+    vector<Vector3> faceValues(faces.getFaceCount());
+    processRanges(faces.getFaceCount(), threadCount, [&](size_t begin, size_t end)
+    {
+        faces.forEachFace(begin, end, [&](size_t face, const uint32_t* indices)
+        {
+            faceValues[face] = computeValue(indices);
+        });
+    });
+
+    // Build the list of faces that reference each vertex, in face order.
+    vector<size_t> vertexOffsets(vertexCount + 1, 0);
+    faces.forEachFace(0, faces.getFaceCount(), [&](size_t, const uint32_t* indices)
+    {
+        for (size_t i = 0; i < FACE_VERTEX_COUNT; i++)
+        {
+            vertexOffsets[indices[i] + 1]++;
+        }
+    });
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        vertexOffsets[v + 1] += vertexOffsets[v];
+    }
+    vector<size_t> vertexFaces(vertexOffsets[vertexCount]);
+    vector<size_t> nextVertexFace(vertexOffsets.begin(), vertexOffsets.end() - 1);
+    faces.forEachFace(0, faces.getFaceCount(), [&](size_t face, const uint32_t* indices)
+    {
+        for (size_t i = 0; i < FACE_VERTEX_COUNT; i++)
+        {
+            vertexFaces[nextVertexFace[indices[i]]++] = face;
+        }
+    });
+
+    processRanges(vertexCount, threadCount, [&](size_t begin, size_t end)
+    {
+        for (size_t v = begin; v < end; v++)
+        {
+            for (size_t i = vertexOffsets[v]; i < vertexOffsets[v + 1]; i++)
+            {
+                applyValue((uint32_t) v, faceValues[vertexFaces[i]]);
+            }
+        }
+    });
+}
+
+// The minimum number of slots in the hash table of a vertex welder.
+const size_t MIN_SLOT_COUNT = 16;
+
+uint32_t hashVertex(const float* components, size_t componentCount)
+{
+    uint64_t h = 0;
+    for (size_t i = 0; i < componentCount; i++)
+    {
+        // Hash positive and negative zero identically, as they compare equal.
+        uint32_t bits = 0;
+        if (components[i] != 0.0f)
+        {
+            std::memcpy(&bits, &components[i], sizeof(bits));
+        }
+        h = (h ^ bits) * 0x9e3779b97f4a7c15ull;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return (uint32_t) h;
+}
+
+bool equalVertices(const float* lhs, const float* rhs, size_t componentCount)
+{
+    for (size_t i = 0; i < componentCount; i++)
+    {
+        if (lhs[i] != rhs[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // anonymous namespace
 
+//
+// MeshVertexWelder methods
+//
+
+MeshVertexWelder::MeshVertexWelder(size_t componentCount, size_t vertexCount) :
+    _componentCount(componentCount),
+    _vertexCount(0)
+{
+    reserve(vertexCount);
+}
+
+void MeshVertexWelder::reserve(size_t vertexCount)
+{
+    _components.reserve(vertexCount * _componentCount);
+    _hashes.reserve(vertexCount);
+
+    // Keep the load factor of the hash table at or below one half.
+    size_t slotCount = MIN_SLOT_COUNT;
+    while (slotCount < vertexCount * 2)
+    {
+        slotCount *= 2;
+    }
+    if (slotCount > _slots.size())
+    {
+        rehash(slotCount);
+    }
+}
+
+uint32_t MeshVertexWelder::weld(const float* components, bool& added)
+{
+    if ((_vertexCount + 1) * 2 > _slots.size())
+    {
+        rehash(std::max(_slots.size() * 2, MIN_SLOT_COUNT));
+    }
+
+    const uint32_t hash = hashVertex(components, _componentCount);
+    const size_t mask = _slots.size() - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+        // Slots hold one plus the index of their vertex, with zero marking an empty slot.
+        if (_slots[slot] == 0)
+        {
+            _slots[slot] = (uint32_t) (_vertexCount + 1);
+            _hashes.push_back(hash);
+            _components.insert(_components.end(), components, components + _componentCount);
+            added = true;
+            return (uint32_t) _vertexCount++;
+        }
+        const uint32_t index = _slots[slot] - 1;
+        if (_hashes[index] == hash && equalVertices(getVertex(index), components, _componentCount))
+        {
+            added = false;
+            return index;
+        }
+    }
+}
+
+void MeshVertexWelder::rehash(size_t slotCount)
+{
+    _slots.assign(slotCount, 0);
+    const size_t mask = slotCount - 1;
+    for (size_t i = 0; i < _vertexCount; i++)
+    {
+        size_t slot = _hashes[i] & mask;
+        while (_slots[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        _slots[slot] = (uint32_t) (i + 1);
+    }
+}
+
 //
 // Mesh methods
 //
@@ -40,38 +278,28 @@ Mesh::Mesh(const string& name) :
 {
 }
 
-MeshStreamPtr Mesh::generateNormals(MeshStreamPtr positionStream)
+MeshStreamPtr Mesh::generateNormals(MeshStreamPtr positionStream, unsigned int threadCount)
 {
     // Create the normal stream.
     MeshStreamPtr normalStream = MeshStream::create("i_" + MeshStream::NORMAL_ATTRIBUTE, MeshStream::NORMAL_ATTRIBUTE, 0);
     normalStream->resize(positionStream->getSize());
 
-    // Iterate through partitions.
-    for (size_t i = 0; i < getPartitionCount(); i++)
-    {
-        MeshPartitionPtr part = getPartition(i);
+    const Vector3* positions = reinterpret_cast<const Vector3*>(positionStream->getData().data());
+    Vector3* normals = reinterpret_cast<Vector3*>(normalStream->getData().data());
 
-        // Iterate through faces.
-        for (size_t faceIndex = 0; faceIndex < part->getFaceCount(); faceIndex++)
-        {
-            uint32_t i0 = part->getIndices()[faceIndex * FACE_VERTEX_COUNT + 0];
-            uint32_t i1 = part->getIndices()[faceIndex * FACE_VERTEX_COUNT + 1];
-            uint32_t i2 = part->getIndices()[faceIndex * FACE_VERTEX_COUNT + 2];
-
-            const Vector3& p0 = positionStream->getElement<Vector3>(i0);
-            const Vector3& p1 = positionStream->getElement<Vector3>(i1);
-            const Vector3& p2 = positionStream->getElement<Vector3>(i2);
-
-            Vector3& n0 = normalStream->getElement<Vector3>(i0);
-            Vector3& n1 = normalStream->getElement<Vector3>(i1);
-            Vector3& n2 = normalStream->getElement<Vector3>(i2);
-
-            Vector3 faceNormal = (p1 - p0).cross(p2 - p0).getNormalized();
-            n0 = faceNormal;
-            n1 = faceNormal;
-            n2 = faceNormal;
-        }
-    }
+    // Assign each vertex the normal of the last face that references it.
+    FaceList faces(*this);
+    processFaceValues(faces, normalStream->getSize(), threadCount, [&](const uint32_t* indices)
+    {
+        const Vector3& p0 = positions[indices[0]];
+        const Vector3& p1 = positions[indices[1]];
+        const Vector3& p2 = positions[indices[2]];
+        return (p1 - p0).cross(p2 - p0).getNormalized();
+    },
+    [&](uint32_t vertex, const Vector3& faceNormal)
+    {
+        normals[vertex] = faceNormal;
+    });
 
     return normalStream;
 }
@@ -87,7 +315,8 @@ MeshStreamPtr Mesh::generateTextureCoordinates(MeshStreamPtr positionStream)
     return texcoordStream;
 }
 
-MeshStreamPtr Mesh::generateTangents(MeshStreamPtr positionStream, MeshStreamPtr normalStream, MeshStreamPtr texcoordStream)
+MeshStreamPtr Mesh::generateTangents(MeshStreamPtr positionStream, MeshStreamPtr normalStream, MeshStreamPtr texcoordStream,
+                                     unsigned int threadCount)
 {
     size_t vertexCount = positionStream->getData().size() / positionStream->getStride();
     size_t normalCount = normalStream->getData().size() / normalStream->getStride();
@@ -102,76 +331,71 @@ MeshStreamPtr Mesh::generateTangents(MeshStreamPtr positionStream, MeshStreamPtr
     tangentStream->resize(positionStream->getSize());
     std::fill(tangentStream->getData().begin(), tangentStream->getData().end(), 0.0f);
 
-    // Iterate through partitions.
-    for (size_t i = 0; i < getPartitionCount(); i++)
-    {
-        MeshPartitionPtr part = getPartition(i);
-
-        // Iterate through faces.
-        for (size_t faceIndex = 0; faceIndex < part->getFaceCount(); faceIndex++)
-        {
-            uint32_t i0 = part->getIndices()[faceIndex * FACE_VERTEX_COUNT + 0];
-            uint32_t i1 = part->getIndices()[faceIndex * FACE_VERTEX_COUNT + 1];
-            uint32_t i2 = part->getIndices()[faceIndex * FACE_VERTEX_COUNT + 2];
-
-            const Vector3& p0 = positionStream->getElement<Vector3>(i0);
-            const Vector3& p1 = positionStream->getElement<Vector3>(i1);
-            const Vector3& p2 = positionStream->getElement<Vector3>(i2);
-
-            const Vector2& w0 = texcoordStream->getElement<Vector2>(i0);
-            const Vector2& w1 = texcoordStream->getElement<Vector2>(i1);
-            const Vector2& w2 = texcoordStream->getElement<Vector2>(i2);
+    const Vector3* positions = reinterpret_cast<const Vector3*>(positionStream->getData().data());
+    const Vector3* normals = reinterpret_cast<const Vector3*>(normalStream->getData().data());
+    const Vector2* texcoords = reinterpret_cast<const Vector2*>(texcoordStream->getData().data());
+    Vector3* tangents = reinterpret_cast<Vector3*>(tangentStream->getData().data());
 
-            Vector3& t0 = tangentStream->getElement<Vector3>(i0);
-            Vector3& t1 = tangentStream->getElement<Vector3>(i1);
-            Vector3& t2 = tangentStream->getElement<Vector3>(i2);
+    // Accumulate face tangents at each vertex.
+    FaceList faces(*this);
+    processFaceValues(faces, vertexCount, threadCount, [&](const uint32_t* indices)
+    {
+        const Vector3& p0 = positions[indices[0]];
+        const Vector3& p1 = positions[indices[1]];
+        const Vector3& p2 = positions[indices[2]];
 
-            // Based on Eric Lengyel at http://www.terathon.com/code/tangent.html
+        const Vector2& w0 = texcoords[indices[0]];
+        const Vector2& w1 = texcoords[indices[1]];
+        const Vector2& w2 = texcoords[indices[2]];
 
-            Vector3 e1 = p1 - p0;
-            Vector3 e2 = p2 - p0;
+        // Based on Eric Lengyel at http://www.terathon.com/code/tangent.html
 
-            float x1 = w1[0] - w0[0];
-            float x2 = w2[0] - w0[0];
-            float y1 = w1[1] - w0[1];
-            float y2 = w2[1] - w0[1];
+        Vector3 e1 = p1 - p0;
+        Vector3 e2 = p2 - p0;
 
-            float denom = x1 * y2 - x2 * y1;
-            float r = denom ? (1.0f / denom) : 0.0f;
-            Vector3 t = (e1 * y2 - e2 * y1) * r;
+        float x1 = w1[0] - w0[0];
+        float x2 = w2[0] - w0[0];
+        float y1 = w1[1] - w0[1];
+        float y2 = w2[1] - w0[1];
 
-            t0 += t;
-            t1 += t;
-            t2 += t;
-        }
-    }
+        float denom = x1 * y2 - x2 * y1;
+        float r = denom ? (1.0f / denom) : 0.0f;
+        return (e1 * y2 - e2 * y1) * r;
+    },
+    [&](uint32_t vertex, const Vector3& faceTangent)
+    {
+        tangents[vertex] += faceTangent;
+    });
 
     // Iterate through vertices.
-    for (size_t v = 0; v < vertexCount; v++)
+    processRanges(vertexCount, threadCount, [&](size_t begin, size_t end)
     {
-        Vector3& n = normalStream->getElement<Vector3>(v);
-        Vector3& t = tangentStream->getElement<Vector3>(v);
-
-        if (t != Vector3(0.0f))
+        for (size_t v = begin; v < end; v++)
         {
-            // Gram-Schmidt orthogonalize.
-            t = (t - n * n.dot(t)).getNormalized();
-        }
-        else
-        {
-            // Generate an arbitrary tangent.
-            // https://graphics.pixar.com/library/OrthonormalB/paper.pdf
-            float sign = (n[2] < 0.0f) ? -1.0f : 1.0f;
-            float a = -1.0f / (sign + n[2]);
-            float b = n[0] * n[1] * a;
-            t = Vector3(1.0f + sign * n[0] * n[0] * a, sign * b, -sign * n[0]);
+            const Vector3& n = normals[v];
+            Vector3& t = tangents[v];
+
+            if (t != Vector3(0.0f))
+            {
+                // Gram-Schmidt orthogonalize.
+                t = (t - n * n.dot(t)).getNormalized();
+            }
+            else
+            {
+                // Generate an arbitrary tangent.
+                // https://graphics.pixar.com/library/OrthonormalB/paper.pdf
+                float sign = (n[2] < 0.0f) ? -1.0f : 1.0f;
+                float a = -1.0f / (sign + n[2]);
+                float b = n[0] * n[1] * a;
+                t = Vector3(1.0f + sign * n[0] * n[0] * a, sign * b, -sign * n[0]);
+            }
         }
-    }
+    });
 
     return tangentStream;
 }
 
-MeshStreamPtr Mesh::generateBitangents(MeshStreamPtr normalStream, MeshStreamPtr tangentStream)
+MeshStreamPtr Mesh::generateBitangents(MeshStreamPtr normalStream, MeshStreamPtr tangentStream, unsigned int threadCount)
 {
     if (normalStream->getSize() != tangentStream->getSize())
     {
@@ -181,14 +405,16 @@ MeshStreamPtr Mesh::generateBitangents(MeshStreamPtr normalStream, MeshStreamPtr
     MeshStreamPtr bitangentStream = MeshStream::create("i_" + MeshStream::BITANGENT_ATTRIBUTE, MeshStream::BITANGENT_ATTRIBUTE, 0);
     bitangentStream->resize(normalStream->getSize());
 
-    for (size_t i = 0; i < normalStream->getSize(); i++)
+    const Vector3* normals = reinterpret_cast<const Vector3*>(normalStream->getData().data());
+    const Vector3* tangents = reinterpret_cast<const Vector3*>(tangentStream->getData().data());
+    Vector3* bitangents = reinterpret_cast<Vector3*>(bitangentStream->getData().data());
+    processRanges(normalStream->getSize(), threadCount, [&](size_t begin, size_t end)
     {
-        const Vector3& normal = normalStream->getElement<Vector3>(i);
-        const Vector3& tangent = tangentStream->getElement<Vector3>(i);
-
-        Vector3& bitangent = bitangentStream->getElement<Vector3>(i);
-        bitangent = normal.cross(tangent);
-    }
+        for (size_t i = begin; i < end; i++)
+        {
+            bitangents[i] = normals[i].cross(tangents[i]);
+        }
+    });
 
     return bitangentStream;
 }
@@ -216,6 +442,69 @@ void Mesh::mergePartitions()
     addPartition(merged);
 }
 
+void Mesh::weldVertices()
+{
+    size_t componentCount = 0;
+    for (MeshStreamPtr stream : _streams)
+    {
+        if (stream->getSize() != _vertexCount)
+        {
+            return;
+        }
+        componentCount += stream->getStride();
+    }
+    if (_vertexCount == 0 || componentCount == 0)
+    {
+        return;
+    }
+
+    // Gather the components of each vertex across all streams.
+    MeshVertexWelder welder(componentCount, _vertexCount);
+    MeshIndexBuffer remap(_vertexCount);
+    MeshFloatBuffer vertex(componentCount);
+    for (size_t v = 0; v < _vertexCount; v++)
+    {
+        float* dest = vertex.data();
+        for (MeshStreamPtr stream : _streams)
+        {
+            const size_t stride = stream->getStride();
+            const float* source = stream->getData().data() + v * stride;
+            dest = std::copy(source, source + stride, dest);
+        }
+        bool added = false;
+        remap[v] = welder.weld(vertex.data(), added);
+    }
+    if (welder.getVertexCount() == _vertexCount)
+    {
+        return;
+    }
+
+    // Rebuild each stream from the unique vertices.
+    size_t offset = 0;
+    for (MeshStreamPtr stream : _streams)
+    {
+        const size_t stride = stream->getStride();
+        stream->resize(welder.getVertexCount());
+        float* dest = stream->getData().data();
+        for (size_t v = 0; v < welder.getVertexCount(); v++)
+        {
+            const float* source = welder.getVertex(v) + offset;
+            dest = std::copy(source, source + stride, dest);
+        }
+        offset += stride;
+    }
+
+    // Remap the indices of each partition.
+    for (MeshPartitionPtr part : _partitions)
+    {
+        for (uint32_t& index : part->getIndices())
+        {
+            index = remap[index];
+        }
+    }
+    _vertexCount = welder.getVertexCount();
+}
+
 void Mesh::splitByUdims()
 {
     MeshStreamPtr texcoords = getStream(MeshStream::TEXCOORD_ATTRIBUTE, 0);
@@ -226,6 +226,61 @@ class MX_RENDER_API MeshPartition
     size_t _faceCount;
 };
 
+/// @class MeshVertexWelder
+/// A utility class for welding mesh vertices, assigning a single index to
+/// each unique combination of vertex components.
+///
+/// Vertices are compared exactly, component by component, using an
+/// open-addressing hash table, and indices are assigned in the order in
+/// which unique vertices are first seen.
+class MX_RENDER_API MeshVertexWelder
+{
+  public:
+    /// Create a welder for vertices with the given number of float
+    /// components, reserving space for the given number of unique vertices.
+    MeshVertexWelder(size_t componentCount, size_t vertexCount = 0);
+    ~MeshVertexWelder() = default;
+
+    /// Reserve space for the given number of unique vertices.
+    void reserve(size_t vertexCount);
+
+    /// Return the index of the given vertex, adding it to the welder if no
+    /// equal vertex has been seen.
+    /// @param components Pointer to the components of the vertex.
+    /// @param added Set to true if the vertex was added, and false if it
+    ///    matched a previously seen vertex.
+    /// @return The index of the unique vertex.
+    uint32_t weld(const float* components, bool& added);
+
+    /// Return the number of components in each vertex.
+    size_t getComponentCount() const
+    {
+        return _componentCount;
+    }
+
+    /// Return the number of unique vertices.
+    size_t getVertexCount() const
+    {
+        return _vertexCount;
+    }
+
+    /// Return the components of the unique vertex with the given index.
+    const float* getVertex(size_t index) const
+    {
+        return _components.data() + index * _componentCount;
+    }
+
+  private:
+    void rehash(size_t slotCount);
+
+  private:
+    size_t _componentCount;
+    size_t _vertexCount;
+    MeshFloatBuffer _components;
+    vector<uint32_t> _hashes;
+    vector<uint32_t> _slots;
+};
+
 /// Shared pointer to a mesh
 using MeshPtr = shared_ptr<class Mesh>;
 
@@ -311,6 +366,12 @@ class MX_RENDER_API Mesh
         _streams.push_back(stream);
     }
 
+    /// Return the list of mesh streams
+    const MeshStreamList& getStreams() const
+    {
+        return _streams;
+    }
+
     /// Remove a mesh stream
     void removeStream(MeshStreamPtr stream)
     {
@@ -407,25 +468,40 @@ class MX_RENDER_API Mesh
 
     /// Generate face normals from the given positions.
     /// @param positionStream Input position stream
+    /// @param threadCount The number of threads to use. A value of zero selects
+    ///    the number of hardware threads.  Results are independent of the
+    ///    thread count.  Defaults to one.
     /// @return The generated normal stream
-    MeshStreamPtr generateNormals(MeshStreamPtr positionStream);
+    MeshStreamPtr generateNormals(MeshStreamPtr positionStream, unsigned int threadCount = 1);
 
     /// Generate tangents from the given positions, normals, and texture coordinates.
     /// @param positionStream Input position stream
     /// @param normalStream Input normal stream
     /// @param texcoordStream Input texcoord stream
+    /// @param threadCount The number of threads to use. A value of zero selects
+    ///    the number of hardware threads.  Results are independent of the
+    ///    thread count.  Defaults to one.
     /// @return The generated tangent stream, on success; otherwise, a null pointer.
-    MeshStreamPtr generateTangents(MeshStreamPtr positionStream, MeshStreamPtr normalStream, MeshStreamPtr texcoordStream);
+    MeshStreamPtr generateTangents(MeshStreamPtr positionStream, MeshStreamPtr normalStream, MeshStreamPtr texcoordStream,
+                                   unsigned int threadCount = 1);
 
     /// Generate bitangents from the given normals and tangents.
     /// @param normalStream Input normal stream
     /// @param tangentStream Input tangent stream
+    /// @param threadCount The number of threads to use. A value of zero selects
+    ///    the number of hardware threads.  Defaults to one.
     /// @return The generated bitangent stream, on success; otherwise, a null pointer.
-    MeshStreamPtr generateBitangents(MeshStreamPtr normalStream, MeshStreamPtr tangentStream);
+    MeshStreamPtr generateBitangents(MeshStreamPtr normalStream, MeshStreamPtr tangentStream, unsigned int threadCount = 1);
 
     /// Merge all mesh partitions into one.
     void mergePartitions();
 
+    /// Weld the vertices of this mesh, merging vertices whose components are
+    /// equal in every stream, and remapping the indices of all partitions.
+    /// The mesh is left unchanged if the size of any stream differs from its
+    /// vertex count.
+    void weldVertices();
+
     /// Split the mesh into a single partition per UDIM.
     void splitByUdims();
 
@@ -0,0 +1,594 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <MaterialXRender/ShaderCache.h>
+
+#include <MaterialXGenShader/ShaderGenerator.h>
+#include <MaterialXGenShader/Syntax.h>
+
+#include <MaterialXCore/Document.h>
+
+#include <cctype>
+#include <set>
+#include <typeinfo>
+
+MATERIALX_NAMESPACE_BEGIN
+
+namespace
+{
+
+const string CONSTANT_CATEGORY = "constant";
+
+void appendOptions(string& key, const GenOptions& options)
+{
+    key += std::to_string(options.shaderInterfaceType) + " " +
+           std::to_string(options.fileTextureVerticalFlip) + " " +
+           options.targetColorSpaceOverride + " " +
+           options.targetDistanceUnit + " " +
+           std::to_string(options.addUpstreamDependencies) + " " +
+           options.libraryPrefix.asString() + " " +
+           std::to_string(options.emitColorTransforms) + " " +
+           std::to_string(options.elideConstantNodes) + " " +
+           std::to_string(options.foldConstantNodes) + " " +
+           std::to_string(options.mergeDuplicateNodes) + " " +
+           std::to_string(options.specializeUniforms) + " " +
+           std::to_string(options.hwTransparency) + " " +
+           std::to_string(options.hwSpecularEnvironmentMethod) + " " +
+           std::to_string(options.hwDirectionalAlbedoMethod) + " " +
+           std::to_string(options.hwTransmissionRenderMethod) + " " +
+           std::to_string(options.hwAiryFresnelIterations) + " " +
+           std::to_string(options.hwSrgbEncodeOutput) + " " +
+           std::to_string(options.hwWriteDepthMoments) + " " +
+           std::to_string(options.hwShadowMap) + " " +
+           std::to_string(options.hwAmbientOcclusion) + " " +
+           std::to_string(options.hwMaxActiveLightSources) + " " +
+           std::to_string(options.hwNormalizeUdimTexCoords) + " " +
+           std::to_string(options.hwWriteAlbedoTable) + " " +
+           std::to_string(options.hwWriteEnvPrefilter) + " " +
+           std::to_string(options.hwImplicitBitangents) + " " +
+           std::to_string(options.oslImplicitSurfaceShaderConversion) + " " +
+           std::to_string(options.oslConnectCiWrapper) + "\n";
+}
+
+// Return true if the value of the given input is published as a shader
+// uniform, rather than affecting the structure of the generated code.
+bool isVaryingInput(InputPtr input, NodeDefPtr nodeDef, const GenOptions& options)
+{
+    if (options.shaderInterfaceType != SHADER_INTERFACE_COMPLETE)
+    {
+        return false;
+    }
+    if (input->getIsUniform() || input->hasAttribute(ValueElement::ENUM_ATTRIBUTE))
+    {
+        return false;
+    }
+    if (input->getType() == STRING_TYPE_STRING || input->getType() == FILENAME_TYPE_STRING)
+    {
+        return false;
+    }
+
+    // Specialized values are baked into the generated code.  Uniforms are
+    // selected by element path, as reported by ShaderGraph::getSpecializedUniforms.
+    if (options.specializeUniforms &&
+        (options.specializedUniforms.empty() || options.specializedUniforms.count(input->getNamePath())))
+    {
+        return false;
+    }
+
+    NodePtr node = input->getParent()->asA<Node>();
+    if (node)
+    {
+        if (options.elideConstantNodes && node->getCategory() == CONSTANT_CATEGORY)
+        {
+            return false;
+        }
+        InputPtr nodeDefInput = nodeDef ? nodeDef->getActiveInput(input->getName()) : nullptr;
+        if (!nodeDefInput || nodeDefInput->getIsUniform() || nodeDefInput->hasAttribute(ValueElement::ENUM_ATTRIBUTE))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Accumulates a canonical description of a sequence of strings and
+// integers, in which each string is prefixed by its length, so that
+// distinct sequences have distinct descriptions.
+class StructureWriter
+{
+  public:
+    void add(const string& str)
+    {
+        add((uint64_t) str.size());
+        _key += str;
+    }
+
+    void add(uint64_t value)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            _key += (char) (value >> (i * 8));
+        }
+    }
+
+    const string& getKey() const
+    {
+        return _key;
+    }
+
+  private:
+    string _key;
+};
+
+// Return a 64-bit FNV-1a hash of the given string.
+uint64_t hashString(const string& str)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (char c : str)
+    {
+        hash = (hash ^ (unsigned char) c) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+using ElementIndexMap = std::unordered_map<ElementPtr, size_t>;
+using PathIndexMap = std::unordered_map<string, size_t>;
+
+const uint64_t NO_ELEMENT = (uint64_t) -1;
+
+uint64_t getElementIndex(ElementPtr elem, const ElementIndexMap& indices)
+{
+    auto it = elem ? indices.find(elem) : indices.end();
+    return it != indices.end() ? it->second : NO_ELEMENT;
+}
+
+// Return true if the given attribute of the given element either names
+// another element of the graph, whose structural position is written in its
+// place, or has no effect on shader generation.
+bool isSkippedAttribute(const string& attrName, ElementPtr elem)
+{
+    if (attrName == Element::XPOS_ATTRIBUTE || attrName == Element::YPOS_ATTRIBUTE ||
+        attrName == PortElement::NODE_NAME_ATTRIBUTE || attrName == PortElement::NODE_GRAPH_ATTRIBUTE ||
+        attrName == PortElement::INTERFACE_NAME_ATTRIBUTE)
+    {
+        return true;
+    }
+    if (attrName == PortElement::OUTPUT_ATTRIBUTE)
+    {
+        // Node outputs are named by their nodedefs, while other outputs
+        // have arbitrary names.
+        OutputPtr output = elem->asA<PortElement>()->getConnectedOutput();
+        return output && !output->getParent()->isA<Node>();
+    }
+    return false;
+}
+
+void writeElement(StructureWriter& writer, ElementPtr elem, NodeDefPtr nodeDef, bool varying,
+                 const ElementIndexMap& indices)
+{
+    // The names of node ports are defined by nodedefs, while the names of
+    // other elements are arbitrary.
+    ElementPtr parent = elem->getParent();
+    writer.add(elem->getCategory());
+    writer.add(parent && parent->isA<Node>() ? elem->getName() : EMPTY_STRING);
+    if (elem->isA<Node>())
+    {
+        writer.add(nodeDef ? nodeDef->getName() : EMPTY_STRING);
+    }
+
+    // Filename values are written as resolved, since file prefixes and tokens
+    // of enclosing elements are not otherwise part of the structure.
+    ValueElementPtr valueElem = elem->asA<ValueElement>();
+    const bool resolved = valueElem && StringResolver::isResolvedType(valueElem->getType());
+    uint64_t attrCount = 0;
+    for (size_t i = 0; i < elem->getAttributeCount(); i++)
+    {
+        const string& attrName = elem->getAttributeName(i);
+        if (isSkippedAttribute(attrName, elem))
+        {
+            continue;
+        }
+        writer.add(attrName);
+        if (attrName != ValueElement::VALUE_ATTRIBUTE)
+        {
+            writer.add(elem->getAttributeValue(i));
+        }
+        else if (resolved)
+        {
+            writer.add(valueElem->getResolvedValueString());
+        }
+        else if (!varying)
+        {
+            writer.add(elem->getAttributeValue(i));
+        }
+        attrCount++;
+    }
+    writer.add(attrCount);
+
+    if (InputPtr input = elem->asA<Input>())
+    {
+        writer.add(getElementIndex(input->getInterfaceInput(), indices));
+        writer.add(getElementIndex(input->getConnectedOutput(), indices));
+        writer.add(getElementIndex(input->getConnectedNode(), indices));
+        writer.add(input->getActiveColorSpace());
+    }
+    else if (OutputPtr output = elem->asA<Output>())
+    {
+        writer.add(getElementIndex(output->getConnectedOutput(), indices));
+        writer.add(getElementIndex(output->getConnectedNode(), indices));
+    }
+}
+
+void pushUpstream(ElementPtr elem, vector<ElementPtr>& stack)
+{
+    if (InputPtr input = elem->asA<Input>())
+    {
+        stack.push_back(input->getInterfaceInput());
+        stack.push_back(input->getConnectedOutput());
+        stack.push_back(input->getConnectedNode());
+    }
+    else if (OutputPtr output = elem->asA<Output>())
+    {
+        stack.push_back(output->getConnectedOutput());
+        stack.push_back(output->getConnectedNode());
+    }
+}
+
+// Find the structural position of the element with the given path, along
+// with any suffix that names an input not authored on that element.
+bool findStructuralPath(const string& path, const PathIndexMap& indices, size_t& index, string& suffix)
+{
+    auto it = indices.find(path);
+    if (it != indices.end())
+    {
+        index = it->second;
+        suffix.clear();
+        return true;
+    }
+    size_t pos = path.rfind(NAME_PATH_SEPARATOR);
+    if (pos != string::npos)
+    {
+        it = indices.find(path.substr(0, pos));
+        if (it != indices.end())
+        {
+            index = it->second;
+            suffix = path.substr(pos);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Map the element paths of the variables of the given shader onto the
+// elements at the same structural positions in another graph.
+void remapPaths(Shader& shader, const PathIndexMap& fromIndices, const StringVec& toPaths)
+{
+    size_t index = 0;
+    string suffix;
+    for (size_t i = 0; i < shader.numStages(); i++)
+    {
+        const ShaderStage& stage = shader.getStage(i);
+        for (const VariableBlockMap* blocks : { &stage.getUniformBlocks(), &stage.getInputBlocks(), &stage.getOutputBlocks() })
+        {
+            for (const auto& it : *blocks)
+            {
+                for (ShaderPort* port : it.second->getVariableOrder())
+                {
+                    if (findStructuralPath(port->getPath(), fromIndices, index, suffix))
+                    {
+                        port->setPath(toPaths[index] + suffix);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Return true if the given source code contains the given name as a
+// complete identifier.
+bool containsIdentifier(const string& code, const string& name)
+{
+    auto isIdentifierChar = [](char c)
+    {
+        return std::isalnum((unsigned char) c) || c == '_';
+    };
+    for (size_t pos = code.find(name); pos != string::npos; pos = code.find(name, pos + 1))
+    {
+        const size_t end = pos + name.size();
+        if ((pos == 0 || !isIdentifierChar(code[pos - 1])) && (end == code.size() || !isIdentifierChar(code[end])))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+PathIndexMap createPathIndexMap(const StringVec& paths)
+{
+    PathIndexMap indices;
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        indices.emplace(paths[i], i);
+    }
+    return indices;
+}
+
+// Update the uniform variables with the given path to the given value,
+// returning false if no such variable is present, or if the value cannot
+// be updated in the source code of the shader.
+bool patchUniform(Shader& shader, const string& path, ValuePtr value, const Syntax& syntax)
+{
+    // Match the float formatting used by shader generators.
+    ScopedFloatFormatting fmt(Value::FloatFormatFixed);
+
+    bool found = false;
+    for (size_t i = 0; i < shader.numStages(); i++)
+    {
+        ShaderStage& stage = shader.getStage(i);
+        string code = stage.getSourceCode();
+        for (const auto& it : stage.getUniformBlocks())
+        {
+            for (ShaderPort* port : it.second->getVariableOrder())
+            {
+                if (port->getPath() != path)
+                {
+                    continue;
+                }
+                if (!port->getValue() || port->getValue()->getTypeString() != value->getTypeString())
+                {
+                    return false;
+                }
+
+                // Update the default assignment of the uniform, if present.
+                const string assignment = " " + port->getVariable() + " = ";
+                size_t pos = code.find(assignment);
+                if (pos != string::npos)
+                {
+                    const string oldValue = syntax.getValue(port->getType(), *port->getValue(), true);
+                    pos += assignment.size();
+                    const size_t end = pos + oldValue.size();
+                    if (code.compare(pos, oldValue.size(), oldValue) != 0 ||
+                        end >= code.size() || std::isalnum((unsigned char) code[end]) || code[end] == '.')
+                    {
+                        return false;
+                    }
+                    code.replace(pos, oldValue.size(), syntax.getValue(port->getType(), *value, true));
+                }
+
+                port->setValue(value);
+                found = true;
+            }
+        }
+        stage.setSourceCode(code);
+    }
+    return found;
+}
+
+string getValueString(InputPtr input)
+{
+    ValuePtr value = input->getResolvedValue();
+    return value ? value->getValueString() : EMPTY_STRING;
+}
+
+} // anonymous namespace
+
+//
+// ShaderCache structures
+//
+
+// The elements of a graph in structural order, along with the varying
+// inputs among them.
+struct ShaderCache::Structure
+{
+    vector<ElementPtr> elements;
+    StringVec elementPaths;
+    vector<size_t> varyingIndices;
+};
+
+struct ShaderCache::Entry
+{
+    ShaderPtr shader;
+    PathIndexMap elementIndices;
+    StringVec varyingValues;
+    bool nameInSource;
+};
+
+//
+// ShaderCache methods
+//
+
+ShaderCache::ShaderCache() :
+    _hitCount(0),
+    _missCount(0)
+{
+}
+
+ShaderCache::~ShaderCache()
+{
+}
+
+ShaderPtr ShaderCache::getShader(const string& shaderName, ElementPtr elem, GenContext& context)
+{
+    Structure structure;
+    const string key = getStructureKey(elem, context, structure);
+
+    shared_ptr<const Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(key);
+        if (it != _entries.end())
+        {
+            entry = it->second;
+        }
+    }
+
+    // Map a copy of the cached shader onto the requested element, and patch
+    // it with the values of varying inputs.
+    if (entry && (!entry->nameInSource || entry->shader->getName() == shaderName))
+    {
+        ShaderPtr shader = entry->shader->copy(shaderName);
+        remapPaths(*shader, entry->elementIndices, structure.elementPaths);
+
+        const Syntax& syntax = context.getShaderGenerator().getSyntax();
+        bool patched = true;
+        for (size_t i = 0; i < structure.varyingIndices.size(); i++)
+        {
+            const size_t index = structure.varyingIndices[i];
+            InputPtr input = structure.elements[index]->asA<Input>();
+            if (entry->varyingValues[i] == getValueString(input))
+            {
+                continue;
+            }
+            ValuePtr value = input->getResolvedValue();
+            if (!value || !patchUniform(*shader, structure.elementPaths[index], value, syntax))
+            {
+                patched = false;
+                break;
+            }
+        }
+        if (patched)
+        {
+            _hitCount++;
+            return shader;
+        }
+    }
+
+    // Generate a new shader, caching a copy that is isolated from any
+    // changes the caller makes to its uniform values.
+    _missCount++;
+    ShaderPtr shader = context.getShaderGenerator().generate(shaderName, elem, context);
+    if (shader && !entry)
+    {
+        auto newEntry = std::make_shared<Entry>();
+        newEntry->shader = shader->copy();
+        newEntry->elementIndices = createPathIndexMap(structure.elementPaths);
+        for (size_t index : structure.varyingIndices)
+        {
+            newEntry->varyingValues.push_back(getValueString(structure.elements[index]->asA<Input>()));
+        }
+        newEntry->nameInSource = false;
+        for (size_t i = 0; i < shader->numStages(); i++)
+        {
+            if (containsIdentifier(shader->getStage(i).getSourceCode(), shaderName))
+            {
+                newEntry->nameInSource = true;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries[key] = newEntry;
+    }
+    return shader;
+}
+
+uint64_t ShaderCache::getStructureHash(ElementPtr elem, GenContext& context)
+{
+    Structure structure;
+    return hashString(getStructureKey(elem, context, structure));
+}
+
+string ShaderCache::getStructureKey(ElementPtr elem, GenContext& context, Structure& structure)
+{
+    const ShaderGenerator& generator = context.getShaderGenerator();
+    const GenOptions& options = context.getOptions();
+    const string& target = generator.getTarget();
+
+    // Gather the upstream graph in a deterministic order, visiting the port
+    // elements of each element directly after it.
+    ElementIndexMap indices;
+    vector<NodeDefPtr> nodeDefs;
+    vector<ElementPtr> stack = { elem };
+    auto visit = [&](ElementPtr current, NodeDefPtr nodeDef)
+    {
+        if (!current || !indices.emplace(current, structure.elements.size()).second)
+        {
+            return false;
+        }
+        structure.elements.push_back(current);
+        structure.elementPaths.push_back(current->getNamePath());
+        nodeDefs.push_back(nodeDef);
+        pushUpstream(current, stack);
+        return true;
+    };
+    while (!stack.empty())
+    {
+        ElementPtr current = stack.back();
+        stack.pop_back();
+        NodePtr node = current ? current->asA<Node>() : nullptr;
+        NodeDefPtr nodeDef = node ? node->getNodeDef(target) : nullptr;
+        if (!visit(current, nodeDef))
+        {
+            continue;
+        }
+        for (ElementPtr child : current->getChildren())
+        {
+            if (child->isA<PortElement>())
+            {
+                visit(child, nodeDef);
+            }
+        }
+    }
+
+    // Describe the generator and options, and then each element, in which
+    // references to other elements are written as structural positions.
+    StructureWriter writer;
+    string optionString;
+    appendOptions(optionString, options);
+    writer.add(string(typeid(generator).name()) + " " + target);
+    writer.add(optionString);
+    for (size_t i = 0; i < structure.elements.size(); i++)
+    {
+        ElementPtr current = structure.elements[i];
+        InputPtr input = current->asA<Input>();
+        bool varying = input && isVaryingInput(input, nodeDefs[i], options);
+        if (varying)
+        {
+            structure.varyingIndices.push_back(i);
+        }
+        writeElement(writer, current, nodeDefs[i], varying, indices);
+    }
+
+    // Describe the selection of specialized uniforms by structural position.
+    if (options.specializeUniforms && !options.specializedUniforms.empty())
+    {
+        PathIndexMap pathIndices = createPathIndexMap(structure.elementPaths);
+        size_t index = 0;
+        string suffix;
+        std::set<string> selection;
+        for (const string& path : options.specializedUniforms)
+        {
+            if (findStructuralPath(path, pathIndices, index, suffix))
+            {
+                selection.insert("#" + std::to_string(index) + suffix);
+            }
+            else
+            {
+                selection.insert(path);
+            }
+        }
+        for (const string& uniform : selection)
+        {
+            writer.add(uniform);
+        }
+    }
+
+    return writer.getKey();
+}
+
+void ShaderCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _hitCount = 0;
+    _missCount = 0;
+}
+
+size_t ShaderCache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+MATERIALX_NAMESPACE_END
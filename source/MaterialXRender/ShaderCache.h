@@ -0,0 +1,108 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef MATERIALX_SHADERCACHE_H
+#define MATERIALX_SHADERCACHE_H
+
+/// @file
+/// Cache of generated shaders, keyed on material graph structure
+
+#include <MaterialXRender/Export.h>
+
+#include <MaterialXGenShader/GenContext.h>
+#include <MaterialXGenShader/Shader.h>
+
+#include <atomic>
+#include <mutex>
+
+MATERIALX_NAMESPACE_BEGIN
+
+class ShaderCache;
+
+/// A shared pointer to a ShaderCache
+using ShaderCachePtr = shared_ptr<ShaderCache>;
+
+/// @class ShaderCache
+/// A thread-safe cache of generated shaders, keyed on a canonical description
+/// of the structure of the upstream graph of each renderable element.
+///
+/// The structure of a graph includes its connections, nodedefs, types and
+/// uniform input values, along with the shader generation target and options.
+/// Filename values are included as resolved against the file prefixes and
+/// tokens that are active at their scope.
+/// It excludes the names of nodes and graphs and the values of varying inputs,
+/// so materials that differ only in these respects share a single shader.
+/// When a requested element matches the structure of a cached shader, a copy
+/// of the cached shader is returned.  The element paths of its variables are
+/// mapped by structural position onto the requested element, and the values
+/// of its uniform variables and their default assignments in source code are
+/// updated to match the requested element.
+///
+/// A shared shader keeps the variable names in source code and the shader
+/// graph of the element for which it was first generated.  A shader whose
+/// source code contains its name as an identifier, as with OSL, is only
+/// shared between requests for the same shader name.
+///
+/// The cache assumes that the data libraries and any state of the generation
+/// context outside of its options, such as bound light shaders and source code
+/// search paths, remain fixed for the lifetime of the cache.
+class MX_RENDER_API ShaderCache
+{
+  public:
+    ShaderCache();
+    ~ShaderCache();
+
+    /// Create a new shader cache.
+    static ShaderCachePtr create()
+    {
+        return std::make_shared<ShaderCache>();
+    }
+
+    /// Return a shader for the given element, reusing a cached shader of
+    /// matching structure if present, and otherwise generating a new shader
+    /// and adding it to the cache.
+    ShaderPtr getShader(const string& shaderName, ElementPtr elem, GenContext& context);
+
+    /// Return a 64-bit hash of the structure of the shader that would be
+    /// generated for the given element in the given context.  Elements that
+    /// differ only in the names of nodes and graphs and the values of varying
+    /// inputs have equal hashes.  Cached shaders are matched on the complete
+    /// structure, so distinct structures with colliding hashes never share
+    /// a shader.
+    static uint64_t getStructureHash(ElementPtr elem, GenContext& context);
+
+    /// Clear all shaders from the cache, and reset its hit and miss counts.
+    void clear();
+
+    /// Return the number of shaders currently held in the cache.
+    size_t size() const;
+
+    /// Return the number of requests that were served from the cache.
+    size_t getHitCount() const
+    {
+        return _hitCount;
+    }
+
+    /// Return the number of requests that required a new shader to be generated.
+    size_t getMissCount() const
+    {
+        return _missCount;
+    }
+
+  private:
+    struct Structure;
+    struct Entry;
+
+    static string getStructureKey(ElementPtr elem, GenContext& context, Structure& structure);
+
+    std::unordered_map<string, shared_ptr<const Entry>> _entries;
+    mutable std::mutex _mutex;
+    std::atomic<size_t> _hitCount;
+    std::atomic<size_t> _missCount;
+};
+
+MATERIALX_NAMESPACE_END
+
+#endif
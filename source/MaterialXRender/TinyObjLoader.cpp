@@ -19,6 +19,7 @@
     #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
 #include <iostream>
 
 MATERIALX_NAMESPACE_BEGIN
@@ -29,18 +30,10 @@ namespace
 const float MAX_FLOAT = std::numeric_limits<float>::max();
 const size_t FACE_VERTEX_COUNT = 3;
 
-class VertexVector : public VectorN<VertexVector, float, 8>
-{
-  public:
-    using VectorN<VertexVector, float, 8>::VectorN;
-    VertexVector(const Vector3& p, const Vector3& n, const Vector2& t) :
-        VectorN(Uninit{})
-    {
-        _arr = { p[0], p[1], p[2], n[0], n[1], n[2], t[0], t[1] };
-    }
-};
-
-using VertexIndexMap = std::unordered_map<VertexVector, uint32_t, VertexVector::Hash>;
+// Vertices are welded on their position, normal, and texture coordinate.
+const size_t NORMAL_OFFSET = MeshStream::STRIDE_3D;
+const size_t TEXCOORD_OFFSET = NORMAL_OFFSET + MeshStream::STRIDE_3D;
+const size_t VERTEX_SIZE = TEXCOORD_OFFSET + MeshStream::STRIDE_2D;
 
 } // anonymous namespace
 
@@ -78,7 +71,29 @@ bool TinyObjLoader::load(const FilePath& filePath, MeshList& meshList, bool texc
     Vector3 boxMin = { MAX_FLOAT, MAX_FLOAT, MAX_FLOAT };
     Vector3 boxMax = { -MAX_FLOAT, -MAX_FLOAT, -MAX_FLOAT };
 
-    VertexIndexMap vertexIndexMap;
+    // Reserve space for the expected number of vertices, which is exact when
+    // vertices are not welded.
+    size_t totalIndexCount = 0;
+    for (const tinyobj::shape_t& shape : shapes)
+    {
+        totalIndexCount += shape.mesh.indices.size();
+    }
+    size_t vertexCount = totalIndexCount;
+    if (_weldVertices)
+    {
+        vertexCount = std::max({ attrib.vertices.size() / MeshStream::STRIDE_3D,
+                                 attrib.normals.size() / MeshStream::STRIDE_3D,
+                                 attrib.texcoords.size() / MeshStream::STRIDE_2D });
+        vertexCount = std::min(vertexCount, totalIndexCount);
+    }
+    positionStream->reserve(vertexCount);
+    normalStream->reserve(vertexCount);
+    texcoordStream->reserve(vertexCount);
+    MeshFloatBuffer& positions = positionStream->getData();
+    MeshFloatBuffer& normals = normalStream->getData();
+    MeshFloatBuffer& texcoords = texcoordStream->getData();
+
+    MeshVertexWelder welder(VERTEX_SIZE, _weldVertices ? vertexCount : 0);
     uint32_t nextVertexIndex = 0;
     bool normalsFound = false;
     for (const tinyobj::shape_t& shape : shapes)
@@ -98,58 +113,57 @@ bool TinyObjLoader::load(const FilePath& filePath, MeshList& meshList, bool texc
         MeshIndexBuffer& indices = part->getIndices();
         indices.resize(indexCount);
 
-        for (size_t i = 0; i < shape.mesh.indices.size(); i++)
+        for (size_t i = 0; i < indexCount; i++)
         {
             const tinyobj::index_t& indexObj = shape.mesh.indices[i];
 
             // Read vertex components.
-            Vector3 position, normal;
-            Vector2 texcoord;
-            for (unsigned int k = 0; k < MeshStream::STRIDE_3D; k++)
+            float vertex[VERTEX_SIZE] = {};
+            const float* position = &attrib.vertices[indexObj.vertex_index * MeshStream::STRIDE_3D];
+            std::copy(position, position + MeshStream::STRIDE_3D, vertex);
+            if (indexObj.normal_index >= 0)
             {
-                position[k] = attrib.vertices[indexObj.vertex_index * MeshStream::STRIDE_3D + k];
-                if (indexObj.normal_index >= 0)
-                {
-                    normal[k] = attrib.normals[indexObj.normal_index * MeshStream::STRIDE_3D + k];
-                    normalsFound = true;
-                }
-                if (indexObj.texcoord_index >= 0 && k < MeshStream::STRIDE_2D)
-                {
-                    texcoord[k] = attrib.texcoords[indexObj.texcoord_index * MeshStream::STRIDE_2D + k];
-                }
-                if (texcoordVerticalFlip && k == 1)
-                {
-                    texcoord[k] = 1.0f - texcoord[k];
-                }
+                const float* normal = &attrib.normals[indexObj.normal_index * MeshStream::STRIDE_3D];
+                std::copy(normal, normal + MeshStream::STRIDE_3D, vertex + NORMAL_OFFSET);
+                normalsFound = true;
             }
-
-            // Check for duplicate vertices.
-            VertexVector vec(position, normal, texcoord);
-            VertexIndexMap::iterator it = vertexIndexMap.find(vec);
-            if (it != vertexIndexMap.end())
+            if (indexObj.texcoord_index >= 0)
             {
-                indices[i] = it->second;
-                continue;
+                const float* texcoord = &attrib.texcoords[indexObj.texcoord_index * MeshStream::STRIDE_2D];
+                std::copy(texcoord, texcoord + MeshStream::STRIDE_2D, vertex + TEXCOORD_OFFSET);
+            }
+            if (texcoordVerticalFlip)
+            {
+                vertex[TEXCOORD_OFFSET + 1] = 1.0f - vertex[TEXCOORD_OFFSET + 1];
             }
-            vertexIndexMap[vec] = nextVertexIndex;
 
-            // Store vertex components.
-            for (unsigned int k = 0; k < MeshStream::STRIDE_3D; k++)
+            // Check for duplicate vertices.
+            if (_weldVertices)
             {
-                positionStream->getData().push_back(position[k]);
-                normalStream->getData().push_back(normal[k]);
-                if (k < MeshStream::STRIDE_2D)
+                bool added = false;
+                indices[i] = welder.weld(vertex, added);
+                if (!added)
                 {
-                    texcoordStream->getData().push_back(texcoord[k]);
+                    continue;
                 }
-
-                // Update bounds.
-                boxMin[k] = std::min(position[k], boxMin[k]);
-                boxMax[k] = std::max(position[k], boxMax[k]);
             }
+            else
+            {
+                indices[i] = nextVertexIndex;
+            }
+            nextVertexIndex++;
 
-            // Store index data.
-            indices[i] = nextVertexIndex++;
+            // Store vertex components.
+            positions.insert(positions.end(), vertex, vertex + NORMAL_OFFSET);
+            normals.insert(normals.end(), vertex + NORMAL_OFFSET, vertex + TEXCOORD_OFFSET);
+            texcoords.insert(texcoords.end(), vertex + TEXCOORD_OFFSET, vertex + VERTEX_SIZE);
+
+            // Update bounds.
+            for (size_t k = 0; k < MeshStream::STRIDE_3D; k++)
+            {
+                boxMin[k] = std::min(vertex[k], boxMin[k]);
+                boxMax[k] = std::max(vertex[k], boxMax[k]);
+            }
         }
     }
 
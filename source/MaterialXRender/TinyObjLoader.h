@@ -21,7 +21,8 @@ using TinyObjLoaderPtr = std::shared_ptr<class TinyObjLoader>;
 class MX_RENDER_API TinyObjLoader : public GeometryLoader
 {
   public:
-    TinyObjLoader()
+    TinyObjLoader() :
+        _weldVertices(true)
     {
         _extensions = { "obj", "OBJ" };
     }
@@ -32,6 +33,25 @@ class MX_RENDER_API TinyObjLoader : public GeometryLoader
 
     /// Load geometry from disk
     bool load(const FilePath& filePath, MeshList& meshList, bool texcoordVerticalFlip = false) override;
+
+    /// Set whether vertices with identical positions, normals, and texture
+    /// coordinates are welded into a single vertex.  When disabled, each face
+    /// vertex is written directly to the mesh streams as a unique vertex, which
+    /// is faster and uses less memory, but generated normals are faceted.
+    /// Defaults to true.
+    void setWeldVertices(bool enable)
+    {
+        _weldVertices = enable;
+    }
+
+    /// Return whether vertices are welded on load.
+    bool getWeldVertices() const
+    {
+        return _weldVertices;
+    }
+
+  private:
+    bool _weldVertices;
 };
 
 MATERIALX_NAMESPACE_END
@@ -12,8 +12,12 @@ MATERIALX_NAMESPACE_BEGIN
 const Color3 DEFAULT_SCREEN_COLOR_SRGB(0.3f, 0.3f, 0.32f);
 const Color3 DEFAULT_SCREEN_COLOR_LIN_REC709(DEFAULT_SCREEN_COLOR_SRGB.srgbToLinear());
 
-ShaderPtr createShader(const string& shaderName, GenContext& context, ElementPtr elem)
+ShaderPtr createShader(const string& shaderName, GenContext& context, ElementPtr elem, ShaderCachePtr cache)
 {
+    if (cache)
+    {
+        return cache->getShader(shaderName, elem, context);
+    }
     return context.getShaderGenerator().generate(shaderName, elem, context);
 }
 
@@ -10,6 +10,7 @@
 /// Rendering utility methods
 
 #include <MaterialXRender/Export.h>
+#include <MaterialXRender/ShaderCache.h>
 
 #include <MaterialXGenShader/GenContext.h>
 #include <MaterialXGenShader/ShaderGenerator.h>
@@ -25,8 +26,10 @@ extern MX_RENDER_API const Color3 DEFAULT_SCREEN_COLOR_LIN_REC709;
 /// @name Shader Utilities
 /// @{
 
-/// Create a shader for a given element.
-MX_RENDER_API ShaderPtr createShader(const string& shaderName, GenContext& context, ElementPtr elem);
+/// Create a shader for a given element.  If a shader cache is provided, then
+/// a cached shader with matching graph structure is reused where possible.
+MX_RENDER_API ShaderPtr createShader(const string& shaderName, GenContext& context, ElementPtr elem,
+                                     ShaderCachePtr cache = nullptr);
 
 /// Create a shader with a constant color output, using the given standard libraries
 /// for code generation.
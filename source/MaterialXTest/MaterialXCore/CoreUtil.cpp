@@ -8,6 +8,8 @@
 #include <MaterialXCore/Util.h>
 #include <MaterialXCore/Document.h>
 
+#include <atomic>
+
 namespace mx = MaterialX;
 
 TEST_CASE("Version comparison", "[coreutil]")
@@ -51,6 +53,48 @@ TEST_CASE("String utilities", "[coreutil]")
     REQUIRE(!mx::stringEndsWith("testName", "test"));
 }
 
+TEST_CASE("Parallel utilities", "[coreutil]")
+{
+    const size_t count = 1000;
+    for (unsigned int threadCount : { 0u, 1u, 4u })
+    {
+        // Each index is processed exactly once, by a valid worker.
+        unsigned int workerCount = mx::getParallelWorkerCount(count, threadCount);
+        std::vector<std::atomic<int>> visits(count);
+        std::atomic<bool> validWorkers(true);
+        mx::parallelFor(count, threadCount, [&](size_t i, unsigned int worker)
+        {
+            visits[i]++;
+            if (worker >= workerCount)
+            {
+                validWorkers = false;
+            }
+        });
+        REQUIRE(validWorkers);
+        REQUIRE(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) { return v == 1; }));
+
+        // The exception for the lowest failing index is rethrown.
+        try
+        {
+            mx::parallelFor(count, threadCount, [](size_t i, unsigned int)
+            {
+                if (i % 100 == 50)
+                {
+                    throw mx::Exception("Failure at index " + std::to_string(i));
+                }
+            });
+            FAIL("Expected an exception");
+        }
+        catch (mx::Exception& e)
+        {
+            REQUIRE(std::string(e.what()) == "Failure at index 50");
+        }
+    }
+    REQUIRE(mx::getParallelWorkerCount(0, 4) == 1);
+    REQUIRE(mx::getParallelWorkerCount(3, 4) == 3);
+    REQUIRE(mx::getParallelWorkerCount(10, 1) == 1);
+}
+
 TEST_CASE("Print utilities", "[coreutil]")
 {
     // Create a document.
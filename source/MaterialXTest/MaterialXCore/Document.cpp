@@ -10,8 +10,44 @@
 #include <MaterialXFormat/Util.h>
 #include <MaterialXFormat/XmlIo.h>
 
+#include <atomic>
+#include <iostream>
+#include <thread>
+
 namespace mx = MaterialX;
 
+namespace
+{
+
+// An estimate of the memory owned by the elements of a document, excluding
+// the document itself and any data library that it references.
+struct DocumentFootprint
+{
+    size_t elementCount = 0;
+    size_t stringBytes = 0;
+};
+
+DocumentFootprint getDocumentFootprint(mx::DocumentPtr doc)
+{
+    DocumentFootprint footprint;
+    for (mx::ElementPtr elem : doc->traverseTree())
+    {
+        if (elem == doc)
+        {
+            continue;
+        }
+        footprint.elementCount++;
+        footprint.stringBytes += elem->getName().size();
+        for (size_t i = 0; i < elem->getAttributeCount(); i++)
+        {
+            footprint.stringBytes += elem->getAttributeName(i).size() + elem->getAttributeValue(i).size();
+        }
+    }
+    return footprint;
+}
+
+} // anonymous namespace
+
 TEST_CASE("Document", "[document]")
 {
     // Create a document.
@@ -271,3 +307,236 @@ TEST_CASE("Document equivalence", "[document]")
     equivalent = doc->isEquivalent(doc2, options, &message);
     REQUIRE(!equivalent);
 }
+
+TEST_CASE("Document cache", "[document]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+
+    // Create a nodedef, an implementation, and a graph referencing them.
+    mx::NodeDefPtr nodeDef = doc->addNodeDef("ND_simpleSrf", mx::SURFACE_SHADER_TYPE_STRING, "simpleSrf");
+    mx::ImplementationPtr impl = doc->addImplementation("IM_simpleSrf");
+    impl->setNodeDef(nodeDef);
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    mx::NodePtr constant = nodeGraph->addNode("constant");
+    mx::OutputPtr output = nodeGraph->addOutput();
+    output->setConnectedNode(constant);
+    REQUIRE(doc->getMatchingNodeDefs("simpleSrf") == std::vector<mx::NodeDefPtr>{ nodeDef });
+    REQUIRE(doc->getMatchingImplementations("ND_simpleSrf") == std::vector<mx::InterfaceElementPtr>{ impl });
+    REQUIRE(doc->getMatchingPorts(constant->getName()) == std::vector<mx::PortElementPtr>{ output });
+
+    // Edits are reflected by lookups without invalidating the cache.
+    mx::NodeDefPtr nodeDef2 = doc->addNodeDef("ND_simpleSrf2", mx::SURFACE_SHADER_TYPE_STRING, "simpleSrf");
+    REQUIRE(doc->getMatchingNodeDefs("simpleSrf") == std::vector<mx::NodeDefPtr>{ nodeDef, nodeDef2 });
+    nodeDef->setNodeString("otherSrf");
+    REQUIRE(doc->getMatchingNodeDefs("simpleSrf") == std::vector<mx::NodeDefPtr>{ nodeDef2 });
+    REQUIRE(doc->getMatchingNodeDefs("otherSrf") == std::vector<mx::NodeDefPtr>{ nodeDef });
+    impl->removeAttribute(mx::InterfaceElement::NODE_DEF_ATTRIBUTE);
+    REQUIRE(doc->getMatchingImplementations("ND_simpleSrf").empty());
+    constant->setName("constant1");
+    output->setNodeName("constant1");
+    REQUIRE(doc->getMatchingPorts("constant1") == std::vector<mx::PortElementPtr>{ output });
+    REQUIRE(doc->getMatchingPorts(mx::EMPTY_STRING).empty());
+
+    // Namespace changes apply to all descendants.
+    doc->setNamespace("custom");
+    REQUIRE(doc->getMatchingNodeDefs("simpleSrf").empty());
+    REQUIRE(doc->getMatchingNodeDefs("custom:simpleSrf") == std::vector<mx::NodeDefPtr>{ nodeDef2 });
+    REQUIRE(doc->getMatchingPorts("custom:constant1") == std::vector<mx::PortElementPtr>{ output });
+    doc->removeAttribute(mx::Element::NAMESPACE_ATTRIBUTE);
+
+    // Removed elements, and later edits to them, are no longer visible.
+    doc->removeNodeGraph(nodeGraph->getName());
+    REQUIRE(doc->getMatchingPorts("constant1").empty());
+    output->setNodeName("constant2");
+    REQUIRE(doc->getMatchingPorts("constant2").empty());
+
+    // Incremental results match a full rebuild of the cache.
+    mx::NodeGraphPtr implGraph = doc->addNodeGraph("NG_simpleSrf2");
+    implGraph->copyContentFrom(nodeGraph);
+    implGraph->setNodeDef(nodeDef2);
+    std::vector<mx::NodeDefPtr> nodeDefs = doc->getMatchingNodeDefs("simpleSrf");
+    std::vector<mx::InterfaceElementPtr> impls = doc->getMatchingImplementations("ND_simpleSrf2");
+    std::vector<mx::PortElementPtr> ports = doc->getMatchingPorts("constant2");
+    REQUIRE(impls.size() == 1);
+    REQUIRE(ports.size() == 1);
+    doc->invalidateCache();
+    REQUIRE(doc->getMatchingNodeDefs("simpleSrf") == nodeDefs);
+    REQUIRE(doc->getMatchingImplementations("ND_simpleSrf2") == impls);
+    REQUIRE(doc->getMatchingPorts("constant2") == ports);
+}
+
+TEST_CASE("Document concurrent lookups", "[document]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, doc);
+
+    // Record the expected results of serial lookups.
+    std::vector<std::string> nodeStrings;
+    std::vector<size_t> expectedCounts;
+    for (mx::NodeDefPtr nodeDef : doc->getNodeDefs())
+    {
+        nodeStrings.push_back(nodeDef->getNodeString());
+        expectedCounts.push_back(doc->getMatchingNodeDefs(nodeDef->getNodeString()).size() +
+                                 doc->getMatchingImplementations(nodeDef->getName()).size());
+    }
+    REQUIRE(!nodeStrings.empty());
+
+    // Repeat the lookups from multiple threads.
+    const size_t threadCount = 4;
+    std::vector<std::thread> threads;
+    std::vector<size_t> mismatches(threadCount, 0);
+    std::vector<mx::NodeDefPtr> nodeDefs = doc->getNodeDefs();
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (size_t i = 0; i < nodeDefs.size(); i++)
+            {
+                size_t count = doc->getMatchingNodeDefs(nodeStrings[i]).size() +
+                               doc->getMatchingImplementations(nodeDefs[i]->getName()).size();
+                if (count != expectedCounts[i])
+                {
+                    mismatches[t]++;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    for (size_t mismatch : mismatches)
+    {
+        REQUIRE(mismatch == 0);
+    }
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    // Measure lookup throughput as the thread count increases.
+    for (size_t benchThreadCount : { 1, 2, 4, 8 })
+    {
+        BENCHMARK("Nodedef and implementation lookups with " + std::to_string(benchThreadCount) + " threads")
+        {
+            std::vector<std::thread> benchThreads;
+            std::atomic<size_t> total(0);
+            for (size_t t = 0; t < benchThreadCount; t++)
+            {
+                benchThreads.emplace_back([&]()
+                {
+                    size_t count = 0;
+                    for (size_t i = 0; i < nodeDefs.size(); i++)
+                    {
+                        count += doc->getMatchingNodeDefs(nodeStrings[i]).size() +
+                                 doc->getMatchingImplementations(nodeDefs[i]->getName()).size();
+                    }
+                    total += count;
+                });
+            }
+            for (std::thread& thread : benchThreads)
+            {
+                thread.join();
+            }
+            return total.load();
+        };
+    }
+#endif
+}
+
+TEST_CASE("Document data library", "[document]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr stdlib = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, stdlib);
+
+    // Build a chain of layered data libraries.
+    mx::DocumentPtr customLib = mx::createDocument();
+    customLib->setDataLibrary(stdlib);
+    mx::NodeDefPtr customNodeDef = customLib->addNodeDef("ND_customSrf", mx::SURFACE_SHADER_TYPE_STRING, "customSrf");
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->setDataLibrary(customLib);
+    REQUIRE(doc->getNodeDef("ND_customSrf") == customNodeDef);
+    REQUIRE(doc->getNodeDef("ND_image_color3") == stdlib->getNodeDef("ND_image_color3"));
+    REQUIRE(doc->getTypeDef("color3") == stdlib->getTypeDef("color3"));
+    REQUIRE(doc->getMatchingNodeDefs("customSrf") == std::vector<mx::NodeDefPtr>{ customNodeDef });
+    REQUIRE(doc->getMatchingNodeDefs("image").size() == stdlib->getMatchingNodeDefs("image").size());
+
+    // Elements of the document take precedence over library elements, and
+    // shadow library elements of the same name in all lookups.
+    mx::ImplementationPtr customImpl = customLib->addImplementation("IM_customSrf");
+    customImpl->setNodeDef(customNodeDef);
+    mx::NodePtr customNode = doc->addNode("customSrf", "customSrf1", mx::SURFACE_SHADER_TYPE_STRING);
+    REQUIRE(customNode->getNodeDef() == customNodeDef);
+    const size_t nodeDefCount = doc->getNodeDefs().size();
+    mx::NodeDefPtr localNodeDef = doc->addNodeDef("ND_customSrf", mx::SURFACE_SHADER_TYPE_STRING, "customSrf");
+    mx::ImplementationPtr localImpl = doc->addImplementation("IM_customSrf");
+    localImpl->setNodeDef(localNodeDef);
+    REQUIRE(doc->getNodeDef("ND_customSrf") == localNodeDef);
+    REQUIRE(doc->getMatchingNodeDefs("customSrf") == std::vector<mx::NodeDefPtr>{ localNodeDef });
+    REQUIRE(doc->getMatchingImplementations("ND_customSrf") == std::vector<mx::InterfaceElementPtr>{ localImpl });
+    REQUIRE(customNode->getNodeDef() == localNodeDef);
+    REQUIRE(doc->getNodeDefs().size() == nodeDefCount);
+    REQUIRE(doc->getNodeDefs()[0] == localNodeDef);
+    REQUIRE(doc->getImplementations()[0] == localImpl);
+    REQUIRE(customLib->getNodeDef("ND_customSrf") == customNodeDef);
+    doc->removeNodeDef("ND_customSrf");
+    doc->removeImplementation("IM_customSrf");
+    REQUIRE(doc->getNodeDef("ND_customSrf") == customNodeDef);
+    REQUIRE(doc->getMatchingNodeDefs("customSrf") == std::vector<mx::NodeDefPtr>{ customNodeDef });
+    REQUIRE(customNode->getNodeDef() == customNodeDef);
+    doc->removeNode("customSrf1");
+
+    // Lookups through a data library match those of an imported library.
+    mx::DocumentPtr importDoc = mx::createDocument();
+    importDoc->importLibrary(stdlib);
+    mx::DocumentPtr layerDoc = mx::createDocument();
+    layerDoc->setDataLibrary(stdlib);
+    for (mx::NodeDefPtr nodeDef : stdlib->getNodeDefs())
+    {
+        const std::string& nodeString = nodeDef->getNodeString();
+        REQUIRE(layerDoc->getNodeDef(nodeDef->getName()) == nodeDef);
+        REQUIRE(importDoc->getNodeDef(nodeDef->getName())->getName() == nodeDef->getName());
+        REQUIRE(layerDoc->getMatchingNodeDefs(nodeString).size() == importDoc->getMatchingNodeDefs(nodeString).size());
+        REQUIRE(layerDoc->getMatchingImplementations(nodeDef->getName()).size() ==
+                importDoc->getMatchingImplementations(nodeDef->getName()).size());
+    }
+    REQUIRE(layerDoc->getNodeDefs().size() == importDoc->getNodeDefs().size());
+    REQUIRE(layerDoc->getImplementations().size() == importDoc->getImplementations().size());
+
+    // Documents with an imported library own a copy of each library element,
+    // while documents with a shared data library own none.
+    DocumentFootprint libraryFootprint = getDocumentFootprint(stdlib);
+    DocumentFootprint importFootprint = getDocumentFootprint(importDoc);
+    DocumentFootprint layerFootprint = getDocumentFootprint(layerDoc);
+    REQUIRE(importFootprint.elementCount == libraryFootprint.elementCount);
+    REQUIRE(importFootprint.stringBytes >= libraryFootprint.stringBytes);
+    REQUIRE(layerFootprint.elementCount == 0);
+    REQUIRE(layerFootprint.stringBytes == 0);
+
+    // Shared data libraries are not modified by the documents that use them.
+    size_t libraryChildCount = stdlib->getChildren().size();
+    layerDoc->addNodeGraph("NG_local");
+    REQUIRE(stdlib->getChildren().size() == libraryChildCount);
+    REQUIRE(layerDoc->getChildren().size() == 1);
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    // Compare the cost of preparing a document for each approach.
+    BENCHMARK("Document with imported library")
+    {
+        mx::DocumentPtr benchDoc = mx::createDocument();
+        benchDoc->importLibrary(stdlib);
+        return benchDoc->getNodeDef("ND_image_color3");
+    };
+    BENCHMARK("Document with shared data library")
+    {
+        mx::DocumentPtr benchDoc = mx::createDocument();
+        benchDoc->setDataLibrary(stdlib);
+        return benchDoc->getNodeDef("ND_image_color3");
+    };
+
+    // Compare the memory owned by a document for each approach.
+    std::cout << "Document with imported library: " << importFootprint.elementCount << " elements, "
+              << importFootprint.stringBytes << " bytes of names and attributes" << std::endl;
+    std::cout << "Document with shared data library: " << layerFootprint.elementCount << " elements, "
+              << layerFootprint.stringBytes << " bytes of names and attributes" << std::endl;
+#endif
+}
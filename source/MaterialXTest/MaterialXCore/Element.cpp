@@ -69,3 +69,180 @@ TEST_CASE("Element", "[element]")
     }
     REQUIRE_THROWS_AS(orphan->getDocument(), mx::ExceptionOrphanedElement);
 }
+
+TEST_CASE("Element attributes", "[element]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::ElementPtr elem = doc->addChildOfCategory("generic", "elem");
+
+    // Set attributes, preserving the order in which they were first set.
+    elem->setAttribute("attr1", "value1");
+    elem->setAttribute("attr2", "value2");
+    elem->setAttribute("attr3", "value3");
+    elem->setAttribute("attr1", "value4");
+    REQUIRE(elem->getAttributeNames() == mx::StringVec({ "attr1", "attr2", "attr3" }));
+    REQUIRE(elem->getAttributeCount() == 3);
+    REQUIRE(elem->getAttributeName(0) == "attr1");
+    REQUIRE(elem->getAttributeValue(0) == "value4");
+    REQUIRE(elem->getAttribute("attr1") == "value4");
+    REQUIRE(elem->hasAttribute("attr2"));
+    REQUIRE(!elem->hasAttribute("attr4"));
+    REQUIRE(elem->getAttribute("attr4").empty());
+
+    // Remove an attribute.
+    elem->removeAttribute("attr2");
+    elem->removeAttribute("attr4");
+    REQUIRE(elem->getAttributeNames() == mx::StringVec({ "attr1", "attr3" }));
+    REQUIRE(!elem->hasAttribute("attr2"));
+
+    // Custom attribute names are stored by each element.
+    mx::ElementPtr elem2 = doc->addChildOfCategory("generic", "elem2");
+    elem2->setAttribute("attr3", "value3");
+    elem2->setAttribute("attr1", "value4");
+    REQUIRE(elem2->getAttributeName(0) == elem->getAttributeName(1));
+    REQUIRE(&elem2->getAttributeName(0) != &elem->getAttributeName(1));
+
+    // Well-known attribute names are shared with their constants, and may
+    // be queried by either the constant or an equal string.
+    elem2->setAttribute(std::string("type"), "float");
+    REQUIRE(&elem2->getAttributeName(2) == &mx::TypedElement::TYPE_ATTRIBUTE);
+    REQUIRE(elem2->getAttribute(mx::TypedElement::TYPE_ATTRIBUTE) == "float");
+    REQUIRE(elem2->getAttribute(std::string("type")) == "float");
+    elem2->removeAttribute(std::string("type"));
+    REQUIRE(!elem2->hasAttribute(mx::TypedElement::TYPE_ATTRIBUTE));
+
+    // Attribute order is significant for equality, but not equivalence.
+    mx::DocumentPtr doc2 = mx::createDocument();
+    mx::ElementPtr elemCopy = doc2->addChildOfCategory("generic", "elem");
+    elemCopy->setAttribute("attr3", "value3");
+    elemCopy->setAttribute("attr1", "value4");
+    REQUIRE(*elem != *elemCopy);
+    REQUIRE(elem->isEquivalent(elemCopy, mx::ElementEquivalenceOptions()));
+    mx::ElementPtr elem3 = doc->addChildOfCategory("generic", "elem3");
+    elem3->copyContentFrom(elem);
+    REQUIRE(elem3->getAttributeNames() == elem->getAttributeNames());
+    REQUIRE(elem3->getAttribute("attr3") == "value3");
+
+    // Clear attributes by copying from an empty element.
+    elem3->copyContentFrom(doc->addChildOfCategory("generic", "empty"));
+    REQUIRE(elem3->getAttributeCount() == 0);
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    mx::DocumentPtr benchDoc = mx::createDocument();
+    mx::NodeGraphPtr graph = benchDoc->addNodeGraph();
+    for (int i = 0; i < 10000; i++)
+    {
+        mx::NodePtr node = graph->addNode("add", mx::EMPTY_STRING, "color3");
+        mx::InputPtr input = node->addInput("in1", "color3");
+        input->setValueString("0.5, 0.5, 0.5");
+        input->setColorSpace("lin_rec709");
+        input->setNodeName("node1");
+    }
+    BENCHMARK("Look up attributes")
+    {
+        size_t count = 0;
+        for (mx::ElementPtr elem : benchDoc->traverseTree())
+        {
+            count += elem->getAttribute(mx::ValueElement::VALUE_ATTRIBUTE).size();
+            count += elem->hasAttribute(mx::PortElement::NODE_NAME_ATTRIBUTE) ? 1 : 0;
+        }
+        return count;
+    };
+    BENCHMARK("Set attributes")
+    {
+        mx::ElementPtr node = benchDoc->addChildOfCategory("generic");
+        for (int i = 0; i < 1000; i++)
+        {
+            node->setAttribute("attr" + std::to_string(i % 10), "value");
+        }
+        benchDoc->removeChild(node->getName());
+        return node->getAttributeCount();
+    };
+#endif
+}
+
+TEST_CASE("Value element caching", "[element]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodePtr node = doc->addNode("add", "node1", "color3");
+    mx::InputPtr input = node->addInput("in1", "color3");
+    input->setValue(mx::Color3(0.1f, 0.2f, 0.3f));
+
+    // Repeated reads return independent copies of the parsed value.
+    mx::ValuePtr value = input->getValue();
+    REQUIRE(value->asA<mx::Color3>() == mx::Color3(0.1f, 0.2f, 0.3f));
+    REQUIRE(input->getValue() != value);
+    REQUIRE(input->getValue()->isEqual(value));
+    REQUIRE(input->getResolvedValue()->isEqual(value));
+    REQUIRE(input->getTypedValue<mx::Color3>() == mx::Color3(0.1f, 0.2f, 0.3f));
+    REQUIRE(input->getTypedValue<float>() == 0.0f);
+
+    // Edits to a returned value do not affect the element.
+    mx::InputPtr intInput = node->addInput("in4", "integer");
+    intInput->setValue(1);
+    mx::ValuePtr intValue = intInput->getValue();
+    std::static_pointer_cast<mx::TypedValue<int>>(intValue)->setData(5);
+    REQUIRE(intInput->getValueString() == "1");
+    REQUIRE(intInput->getValue()->asA<int>() == 1);
+    REQUIRE(intInput->getTypedValue<int>() == 1);
+    node->removeInput("in4");
+
+    // Edits to the value or type invalidate the cached value.
+    input->setValueString("0.5, 0.5, 0.5");
+    REQUIRE(input->getValue() != value);
+    REQUIRE(input->getValue()->asA<mx::Color3>() == mx::Color3(0.5f));
+    REQUIRE(input->getTypedValue<mx::Color3>() == mx::Color3(0.5f));
+    input->setType("vector3");
+    REQUIRE(input->getValue()->asA<mx::Vector3>() == mx::Vector3(0.5f));
+    REQUIRE(input->getTypedValue<mx::Vector3>() == mx::Vector3(0.5f));
+    REQUIRE(input->getTypedValue<mx::Color3>() == mx::Color3(0.0f));
+    input->removeAttribute(mx::ValueElement::VALUE_ATTRIBUTE);
+    REQUIRE(!input->getValue());
+    REQUIRE(input->getTypedValue<mx::Vector3>() == mx::Vector3(0.0f));
+
+    // Copying or clearing content invalidates the cached value.
+    mx::InputPtr input2 = node->addInput("in2", "float");
+    input2->setValue(1.0f);
+    REQUIRE(input2->getValue()->asA<float>() == 1.0f);
+    mx::InputPtr source = node->addInput("in3", "float");
+    source->setValue(2.0f);
+    input2->copyContentFrom(source);
+    REQUIRE(input2->getValue()->asA<float>() == 2.0f);
+    input2->clearContent();
+    REQUIRE(!input2->getValue());
+
+    // Filename values are resolved on each request.
+    mx::InputPtr file = node->addInput("file", mx::FILENAME_TYPE_STRING);
+    file->setValueString("image.png");
+    node->setFilePrefix("textures/");
+    REQUIRE(file->getValue()->asA<std::string>() == "image.png");
+    REQUIRE(file->getResolvedValue()->asA<std::string>() == "textures/image.png");
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    std::vector<mx::InputPtr> inputs;
+    for (int i = 0; i < 10000; i++)
+    {
+        mx::InputPtr benchInput = node->addInput("bench" + std::to_string(i), "color3");
+        benchInput->setValueString("0.5, 0.25, 0.125");
+        inputs.push_back(benchInput);
+    }
+    BENCHMARK("Get cached values")
+    {
+        float sum = 0.0f;
+        for (mx::InputPtr benchInput : inputs)
+        {
+            sum += benchInput->getValue()->asA<mx::Color3>()[0];
+        }
+        return sum;
+    };
+    BENCHMARK("Get typed values")
+    {
+        float sum = 0.0f;
+        for (mx::InputPtr benchInput : inputs)
+        {
+            sum += benchInput->getTypedValue<mx::Color3>()[0];
+        }
+        return sum;
+    };
+#endif
+}
@@ -7,6 +7,8 @@
 
 #include <MaterialXCore/Document.h>
 
+#include <set>
+
 namespace mx = MaterialX;
 
 TEST_CASE("Look", "[look]")
@@ -123,3 +125,147 @@ TEST_CASE("LookGroup", "[look]")
     lookGroups = doc->getLookGroups();
     REQUIRE(lookGroups.size() == 0);
 }
+
+TEST_CASE("LookIndex", "[look]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodePtr shaderNode = doc->addNode("standard_surface", "", mx::SURFACE_SHADER_TYPE_STRING);
+    mx::NodePtr materialNode = doc->addMaterialNode("", shaderNode);
+    mx::PropertySetPtr propertySet = doc->addPropertySet();
+
+    // Create a hierarchy of geometry paths.
+    mx::StringVec paths = { "/" };
+    for (int i = 0; i < 4; i++)
+    {
+        const std::string robot = "/robot" + std::to_string(i);
+        paths.push_back(robot);
+        for (const char* part : { "left_arm", "right_arm", "head" })
+        {
+            paths.push_back(robot + "/" + part);
+            paths.push_back(robot + "/" + part + "/hand");
+        }
+    }
+
+    // Create nested collections with include and exclude geoms.
+    mx::CollectionPtr robots = doc->addCollection("robots");
+    robots->setIncludeGeom("/robot0, /robot1/head");
+    robots->setExcludeGeom("/robot0/left_arm");
+    mx::CollectionPtr arms = doc->addCollection("arms");
+    arms->setIncludeGeom("/robot2/left_arm/hand");
+    arms->setIncludeCollectionString("robots");
+    mx::CollectionPtr all = doc->addCollection("all");
+    all->setIncludeCollectionString("arms");
+    all->setExcludeGeom("/robot1");
+    mx::CollectionPtr empty = doc->addCollection("empty");
+
+    // Create looks with assignments of each kind, inheriting between looks.
+    mx::LookPtr look1 = doc->addLook("look1");
+    mx::LookPtr look2 = doc->addLook("look2");
+    look2->setInheritsFrom(look1);
+    std::vector<mx::CollectionPtr> collections = { robots, arms, all, empty };
+    for (size_t i = 0; i < paths.size(); i += 3)
+    {
+        mx::LookPtr look = (i % 2) ? look1 : look2;
+        mx::CollectionPtr collection = collections[i % collections.size()];
+        mx::MaterialAssignPtr matAssign = look->addMaterialAssign("", materialNode->getName());
+        matAssign->setGeom(paths[i]);
+        look->addMaterialAssign("", materialNode->getName())->setCollection(collection);
+        mx::PropertyAssignPtr propertyAssign = look->addPropertyAssign();
+        propertyAssign->setGeom(paths[(i + 1) % paths.size()]);
+        propertyAssign->setCollection(collections[(i + 1) % collections.size()]);
+        mx::PropertySetAssignPtr propertySetAssign = look->addPropertySetAssign();
+        propertySetAssign->setPropertySet(propertySet);
+        propertySetAssign->setGeom(paths[(i + 2) % paths.size()] + ", " + paths[(i + 5) % paths.size()]);
+        look->addVisibility()->setCollection(collections[(i + 2) % collections.size()]);
+    }
+
+    // Compare the index against brute-force matching of each assignment.
+    std::set<mx::ElementPtr> visited;
+    auto addMatches = [&](const auto& assigns, const std::string& geom, auto& result)
+    {
+        for (const auto& assign : assigns)
+        {
+            if (!visited.insert(assign).second)
+            {
+                continue;
+            }
+            mx::CollectionPtr collection = assign->getCollection();
+            if (mx::geomStringsMatch(assign->getGeom(), geom, true) ||
+                (collection && collection->matchesGeomString(geom)))
+            {
+                result.push_back(assign);
+            }
+        }
+    };
+    auto getExpected = [&](const std::string& geom)
+    {
+        mx::LookAssignments expected;
+        visited.clear();
+        for (mx::LookPtr look : doc->getLooks())
+        {
+            addMatches(look->getActiveMaterialAssigns(), geom, expected.materialAssigns);
+            addMatches(look->getActivePropertyAssigns(), geom, expected.propertyAssigns);
+            addMatches(look->getActivePropertySetAssigns(), geom, expected.propertySetAssigns);
+            addMatches(look->getActiveVisibilities(), geom, expected.visibilities);
+        }
+        return expected;
+    };
+
+    mx::LookIndexPtr index = mx::LookIndex::create(doc);
+    REQUIRE(index->getAssignmentCount() > 0);
+    mx::StringVec queries = paths;
+    queries.push_back("/robot9");
+    queries.push_back("/robot2/head, /robot3/left_arm/hand/finger");
+    queries.push_back("");
+    std::vector<mx::LookAssignments> bulk = index->getAssignments(queries);
+    REQUIRE(bulk.size() == queries.size());
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        mx::LookAssignments expected = getExpected(queries[i]);
+        mx::LookAssignments single = index->getAssignments(queries[i]);
+        for (const mx::LookAssignments& actual : { single, bulk[i] })
+        {
+            REQUIRE(actual.materialAssigns == expected.materialAssigns);
+            REQUIRE(actual.propertyAssigns == expected.propertyAssigns);
+            REQUIRE(actual.propertySetAssigns == expected.propertySetAssigns);
+            REQUIRE(actual.visibilities == expected.visibilities);
+        }
+    }
+    REQUIRE(!index->getAssignments("/robot0/head").materialAssigns.empty());
+    REQUIRE(index->getAssignments("/robot9").visibilities.empty());
+
+    // Cycles in collection include chains are reported when building the index.
+    robots->setIncludeCollectionString("all");
+    REQUIRE_THROWS_AS(mx::LookIndex::create(doc), mx::ExceptionFoundCycle);
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    robots->setIncludeCollectionString(mx::EMPTY_STRING);
+    mx::LookPtr sceneLook = doc->addLook("scene");
+    mx::StringVec scenePaths;
+    for (int i = 0; i < 2000; i++)
+    {
+        const std::string path = "/scene/asset" + std::to_string(i % 100) + "/mesh" + std::to_string(i);
+        scenePaths.push_back(path);
+        sceneLook->addMaterialAssign("", materialNode->getName())->setGeom(path);
+    }
+    BENCHMARK("Resolve assignments by brute force")
+    {
+        size_t count = 0;
+        for (const std::string& path : scenePaths)
+        {
+            count += getExpected(path).materialAssigns.size();
+        }
+        return count;
+    };
+    BENCHMARK("Resolve assignments with look index")
+    {
+        mx::LookIndexPtr sceneIndex = mx::LookIndex::create(doc);
+        size_t count = 0;
+        for (const mx::LookAssignments& assignments : sceneIndex->getAssignments(scenePaths))
+        {
+            count += assignments.materialAssigns.size();
+        }
+        return count;
+    };
+#endif
+}
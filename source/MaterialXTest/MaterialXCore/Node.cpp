@@ -310,6 +310,149 @@ TEST_CASE("Inheritance", "[nodedef]")
         nodedefSpecularInput->getAttribute(mx::ValueElement::VALUE_ATTRIBUTE));
 }
 
+TEST_CASE("NodeDef Matching", "[nodedef]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr libraries = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, libraries);
+
+    // Matches are found through the data library, once it is assigned.
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodePtr image = doc->addNode("image", "image1", "color3");
+    REQUIRE(!image->getNodeDef());
+    doc->setDataLibrary(libraries);
+    REQUIRE(image->getNodeDef() == libraries->getNodeDef("ND_image_color3"));
+    REQUIRE(image->getNodeDef() == libraries->getNodeDef("ND_image_color3"));
+
+    // Edits to the node signature select a different nodedef.
+    image->setType("float");
+    REQUIRE(image->getNodeDef() == libraries->getNodeDef("ND_image_float"));
+    image->addInput("missing", "float");
+    REQUIRE(!image->getNodeDef());
+    REQUIRE(image->getNodeDef(mx::EMPTY_STRING, true) == libraries->getNodeDef("ND_image_float"));
+    image->removeInput("missing");
+    REQUIRE(image->getNodeDef() == libraries->getNodeDef("ND_image_float"));
+
+    // Edits to nodedefs in the document and its data library are reflected.
+    mx::NodePtr custom = doc->addNode("custom", "custom1", "float");
+    REQUIRE(!custom->getNodeDef());
+    mx::NodeDefPtr customDef = doc->addNodeDef("ND_custom_float", "float", "custom");
+    REQUIRE(custom->getNodeDef() == customDef);
+    customDef->getOutput("out")->setType("color3");
+    REQUIRE(!custom->getNodeDef());
+    customDef->getOutput("out")->setType("float");
+    customDef->setTarget("genglsl");
+    REQUIRE(!custom->getNodeDef("genosl"));
+    REQUIRE(custom->getNodeDef("genglsl") == customDef);
+    customDef->removeAttribute(mx::InterfaceElement::TARGET_ATTRIBUTE);
+    REQUIRE(custom->getNodeDef("genosl") == customDef);
+    mx::InputPtr customInput = customDef->addInput("in", "float");
+    custom->addInput("in", "float");
+    REQUIRE(custom->getNodeDef() == customDef);
+    customInput->setType("color3");
+    REQUIRE(!custom->getNodeDef());
+
+    mx::DocumentPtr libraryCopy = libraries->copy();
+    doc->setDataLibrary(libraryCopy);
+    REQUIRE(image->getNodeDef() == libraryCopy->getNodeDef("ND_image_float"));
+    libraryCopy->removeNodeDef("ND_image_float");
+    REQUIRE(!image->getNodeDef());
+
+    // Renaming nodedef inputs changes which nodedef is matched.
+    mx::NodeDefPtr fooA = doc->addNodeDef("ND_foo_a", "float", "foo");
+    mx::InputPtr fooAInput = fooA->addInput("in", "float");
+    mx::NodeDefPtr fooB = doc->addNodeDef("ND_foo_b", "float", "foo");
+    mx::InputPtr fooBInput = fooB->addInput("other", "float");
+    mx::NodePtr foo = doc->addNode("foo", "foo1", "float");
+    foo->addInput("in", "float");
+    REQUIRE(foo->getNodeDef() == fooA);
+    fooAInput->setName("renamed");
+    fooBInput->setName("in");
+    REQUIRE(foo->getNodeDef() == fooB);
+
+    // Matches follow changes of data library, however many edits each
+    // library has seen.
+    mx::DocumentPtr libraryA = mx::createDocument();
+    mx::NodeDefPtr barA = libraryA->addNodeDef("ND_bar_a", "float", "bar");
+    mx::DocumentPtr libraryB = mx::createDocument();
+    mx::NodeDefPtr barB = libraryB->addNodeDef("ND_bar_b", "float", "bar");
+    mx::DocumentPtr barDoc = mx::createDocument();
+    mx::NodePtr bar = barDoc->addNode("bar", "bar1", "float");
+    for (int i = 0; i < 8; i++)
+    {
+        barDoc->setDataLibrary(libraryA);
+        REQUIRE(bar->getNodeDef() == barA);
+        barDoc->setDataLibrary(libraryB);
+        REQUIRE(bar->getNodeDef() == barB);
+        libraryA->addNodeDef("ND_unused_a" + std::to_string(i), "color3", "unused");
+    }
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    // Measure nodedef resolution for every node in the example materials.
+    std::vector<mx::DocumentPtr> documents;
+    mx::StringVec documentPaths;
+    mx::loadDocuments(searchPath.find("resources/Materials"), searchPath, {}, {}, documents, documentPaths);
+    std::vector<mx::NodePtr> nodes;
+    for (mx::DocumentPtr materialDoc : documents)
+    {
+        materialDoc->setDataLibrary(libraries);
+        for (mx::ElementPtr elem : materialDoc->traverseTree())
+        {
+            if (mx::NodePtr node = elem->asA<mx::Node>())
+            {
+                nodes.push_back(node);
+            }
+        }
+    }
+    BENCHMARK("Resolve nodedefs for " + std::to_string(nodes.size()) + " nodes")
+    {
+        size_t matchCount = 0;
+        for (mx::NodePtr node : nodes)
+        {
+            matchCount += node->getNodeDef() ? 1 : 0;
+        }
+        return matchCount;
+    };
+#endif
+}
+
+TEST_CASE("Implementation Resolution", "[nodedef]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->addTargetDef("basetarget");
+    mx::TargetDefPtr subTarget = doc->addTargetDef("subtarget");
+    subTarget->setInheritString("basetarget");
+    mx::NodeDefPtr nodeDef = doc->addNodeDef("ND_custom_float", "float", "custom");
+    REQUIRE(!nodeDef->getImplementation("subtarget"));
+
+    // Generic and target-specific implementations are resolved, taking
+    // target inheritance into account.
+    mx::ImplementationPtr genericImpl = doc->addImplementation("IM_custom_float");
+    genericImpl->setNodeDef(nodeDef);
+    REQUIRE(nodeDef->getImplementation("subtarget") == genericImpl);
+    mx::ImplementationPtr baseImpl = doc->addImplementation("IM_custom_float_basetarget");
+    baseImpl->setNodeDef(nodeDef);
+    REQUIRE(nodeDef->getImplementation("subtarget") == genericImpl);
+    baseImpl->setTarget("basetarget");
+    REQUIRE(nodeDef->getImplementation("subtarget") == baseImpl);
+    REQUIRE(nodeDef->getImplementation("subtarget") == baseImpl);
+    subTarget->removeAttribute(mx::Element::INHERIT_ATTRIBUTE);
+    REQUIRE(nodeDef->getImplementation("subtarget") == genericImpl);
+    REQUIRE(nodeDef->getImplementation("basetarget") == baseImpl);
+
+    // Implementations are resolved to their linked nodegraphs on request.
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph("NG_custom_float");
+    nodeGraph->setTarget("subtarget");
+    mx::ImplementationPtr graphImpl = doc->addImplementation("IM_custom_float_subtarget");
+    graphImpl->setNodeDef(nodeDef);
+    graphImpl->setTarget("subtarget");
+    graphImpl->setNodeGraph(nodeGraph->getName());
+    REQUIRE(nodeDef->getImplementation("subtarget") == nodeGraph);
+    REQUIRE(nodeDef->getImplementation("subtarget", false) == graphImpl);
+    doc->removeImplementation(graphImpl->getName());
+    REQUIRE(nodeDef->getImplementation("subtarget") == genericImpl);
+}
+
 TEST_CASE("Topological sort", "[nodegraph]")
 {
     // Create a document.
@@ -8,6 +8,8 @@
 #include <MaterialXCore/Util.h>
 #include <MaterialXCore/Value.h>
 
+#include <sstream>
+
 namespace mx = MaterialX;
 
 template<class T> void testTypedValue(const T& v1, const T& v2)
@@ -89,6 +91,118 @@ TEST_CASE("Value strings", "[value]")
     REQUIRE(mx::parseStructValueString("{1;2;{3};4}") == (std::vector<std::string>{"1","2","{3}","4"}));
 }
 
+TEST_CASE("Value string conversion", "[value]")
+{
+    // Reference conversions through classic locale streams.
+    auto streamToString = [](float data)
+    {
+        std::stringstream ss;
+        ss.imbue(std::locale::classic());
+        mx::Value::FloatFormat fmt = mx::Value::getFloatFormat();
+        ss.setf(std::ios_base::fmtflags(
+                (fmt == mx::Value::FloatFormatFixed ? std::ios_base::fixed :
+                (fmt == mx::Value::FloatFormatScientific ? std::ios_base::scientific : 0))),
+            std::ios_base::floatfield);
+        ss.precision(mx::Value::getFloatPrecision());
+        ss << data;
+        return ss.str();
+    };
+    auto streamFromString = [](const std::string& value, float& data)
+    {
+        std::stringstream ss(value);
+        ss.imbue(std::locale::classic());
+        return bool(ss >> data);
+    };
+
+    // Formatting matches streams for each float format and precision.
+    const std::vector<float> floats = { 0.0f, -0.0f, 1.0f, -1.5f, 0.1f, 1.0f / 3.0f, 123456.789f,
+                                        1e-7f, 3.4e38f, 1e-40f, 0.5f, 2.5f, 1e6f, 1e7f };
+    for (mx::Value::FloatFormat format : { mx::Value::FloatFormatDefault,
+                                           mx::Value::FloatFormatFixed,
+                                           mx::Value::FloatFormatScientific })
+    {
+        for (int precision : { 0, 1, 3, 6, 9, 17 })
+        {
+            mx::ScopedFloatFormatting fmt(format, precision);
+            for (float f : floats)
+            {
+                REQUIRE(mx::toValueString(f) == streamToString(f));
+            }
+            REQUIRE(mx::toValueString(mx::Vector2(floats[4], floats[5])) ==
+                    streamToString(floats[4]) + ", " + streamToString(floats[5]));
+        }
+    }
+    REQUIRE(mx::toValueString(-2147483647 - 1) == "-2147483648");
+    REQUIRE(mx::toValueString(mx::IntVec{ 1, -2, 3 }) == "1, -2, 3");
+    REQUIRE(mx::toValueString(mx::FloatVec{ 0.5f, 1.0f }) == "0.5, 1");
+
+    // Parsing matches streams, including for inputs outside the fast path.
+    const mx::StringVec floatStrings = { "1", "-1.5", "0.1", ".5", "-.5", "1e3", "1.5E-3", "  2.5", "+3",
+                                         "1.5abc", "1e", "1e+", "0x10", "1e50", "-1e50", "1e-50",
+                                         "inf", "nan", "-", ".", "", "text", "3.40282347e38" };
+    for (const std::string& str : floatStrings)
+    {
+        float expected = 0.0f;
+        if (streamFromString(str, expected))
+        {
+            REQUIRE(mx::fromValueString<float>(str) == expected);
+        }
+        else
+        {
+            REQUIRE_THROWS_AS(mx::fromValueString<float>(str), mx::ExceptionTypeError);
+        }
+    }
+    REQUIRE(mx::fromValueString<int>("-42") == -42);
+    REQUIRE(mx::fromValueString<int>("7.9") == 7);
+    REQUIRE_THROWS_AS(mx::fromValueString<int>("99999999999"), mx::ExceptionTypeError);
+    REQUIRE(mx::fromValueString<long>("99999999999") == 99999999999l);
+    REQUIRE(mx::fromValueString<double>("0.1") == 0.1);
+    REQUIRE(mx::fromValueString<mx::Vector3>("1,2 ,  3") == mx::Vector3(1.0f, 2.0f, 3.0f));
+    REQUIRE(mx::fromValueString<mx::Matrix33>("1, 2, 3, 4, 5, 6, 7, 8, 9")[1][2] == 6.0f);
+    REQUIRE(mx::fromValueString<mx::IntVec>(" 1 ,2,  3 ") == mx::IntVec{ 1, 2, 3 });
+    REQUIRE(mx::fromValueString<mx::FloatVec>("0.5, -1") == mx::FloatVec{ 0.5f, -1.0f });
+    REQUIRE_THROWS_AS(mx::fromValueString<mx::Vector3>("1, 2, 3, 4"), mx::ExceptionTypeError);
+    REQUIRE_THROWS_AS(mx::fromValueString<mx::Vector3>("1, 2, text"), mx::ExceptionTypeError);
+    REQUIRE_THROWS_AS(mx::fromValueString<mx::Matrix44>("1, 2, 3"), mx::ExceptionTypeError);
+    REQUIRE_THROWS_AS(mx::fromValueString<mx::IntVec>("1, , text"), mx::ExceptionTypeError);
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    const std::vector<std::pair<std::string, std::string>> valueStrings =
+    {
+        { "integer", "42" },
+        { "boolean", "true" },
+        { "float", "0.318309873" },
+        { "color3", "0.18, 0.18, 0.18" },
+        { "color4", "0.18, 0.18, 0.18, 1" },
+        { "vector2", "0.5, -0.25" },
+        { "vector3", "0.25, 0.5, 0.75" },
+        { "vector4", "0.25, 0.5, 0.75, 1" },
+        { "matrix33", "1, 0, 0, 0, 1, 0, 0, 0, 1" },
+        { "matrix44", "1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0.5, 0.25, 0.125, 1" },
+        { "string", "text" },
+        { "integerarray", "1, 2, 3, 4, 5, 6, 7, 8" },
+        { "booleanarray", "true, false, true" },
+        { "floatarray", "0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8" },
+        { "stringarray", "first, second, third" }
+    };
+    for (const auto& pair : valueStrings)
+    {
+        BENCHMARK("Parse value string: " + pair.first)
+        {
+            return mx::Value::createValueFromStrings(pair.second, pair.first);
+        };
+    }
+    for (const auto& pair : valueStrings)
+    {
+        mx::ValuePtr value = mx::Value::createValueFromStrings(pair.second, pair.first);
+        BENCHMARK("Format value string: " + pair.first)
+        {
+            return value->getValueString();
+        };
+    }
+#endif
+}
+
 TEST_CASE("Typed values", "[value]")
 {
     // Base types
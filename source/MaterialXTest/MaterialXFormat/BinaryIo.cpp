@@ -0,0 +1,80 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <MaterialXTest/External/Catch/catch.hpp>
+
+#include <MaterialXFormat/BinaryIo.h>
+#include <MaterialXFormat/Util.h>
+
+#include <filesystem>
+
+namespace mx = MaterialX;
+
+TEST_CASE("Binary round trip", "[binaryio]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr libraries = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, libraries);
+
+    // Add content that exercises namespaces, comments and source URIs.
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "resources/Materials/Examples/StandardSurface/standard_surface_marble_solid.mtlx", searchPath);
+    doc->importLibrary(libraries);
+    doc->addChildOfCategory(mx::CommentElement::CATEGORY)->setDocString("Binary comment");
+
+    // Write and read the document through a string buffer.
+    std::string buffer = mx::writeToBinaryString(doc);
+    mx::DocumentPtr readDoc = mx::createDocument();
+    mx::readFromBinaryBuffer(readDoc, buffer.data(), buffer.size());
+    mx::ElementEquivalenceOptions options;
+    std::string message;
+    bool equivalent = readDoc->isEquivalent(doc, options, &message);
+    INFO(message);
+    REQUIRE(equivalent);
+    REQUIRE(*readDoc == *doc);
+
+    // Verify that source URIs are preserved.
+    mx::TreeIterator it = readDoc->traverseTree();
+    for (mx::ElementPtr elem : doc->traverseTree())
+    {
+        REQUIRE(it != mx::TreeIterator::end());
+        REQUIRE((*it)->getSourceUri() == elem->getSourceUri());
+        ++it;
+    }
+    REQUIRE(readDoc->getMatchingNodeDefs("standard_surface").size() == doc->getMatchingNodeDefs("standard_surface").size());
+
+    // Write and read the document through a file.
+    mx::FilePath filename = "binary_round_trip." + mx::MTLX_BINARY_EXTENSION;
+    mx::writeToBinaryFile(doc, filename);
+    mx::DocumentPtr fileDoc = mx::createDocument();
+    mx::readFromBinaryFile(fileDoc, filename);
+    REQUIRE(fileDoc->isEquivalent(doc, options));
+    REQUIRE(*fileDoc == *doc);
+    std::filesystem::remove(filename.asString());
+
+    // Verify that invalid data is rejected.
+    mx::DocumentPtr invalidDoc = mx::createDocument();
+    REQUIRE_THROWS_AS(mx::readFromBinaryBuffer(invalidDoc, buffer.data(), buffer.size() / 2), mx::ExceptionParseError);
+    REQUIRE_THROWS_AS(mx::readFromBinaryBuffer(invalidDoc, buffer.data() + 1, buffer.size() - 1), mx::ExceptionParseError);
+    REQUIRE_THROWS_AS(mx::readFromBinaryFile(invalidDoc, "missing_file." + mx::MTLX_BINARY_EXTENSION), mx::ExceptionFileMissing);
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    mx::FilePath libraryFilename = "libraries." + mx::MTLX_BINARY_EXTENSION;
+    mx::writeToBinaryFile(libraries, libraryFilename);
+    BENCHMARK("Load data libraries from XML")
+    {
+        mx::DocumentPtr benchDoc = mx::createDocument();
+        mx::loadLibraries({ "libraries" }, searchPath, benchDoc);
+        return benchDoc;
+    };
+    BENCHMARK("Load data libraries from a binary snapshot")
+    {
+        mx::DocumentPtr benchDoc = mx::createDocument();
+        mx::readFromBinaryFile(benchDoc, libraryFilename);
+        return benchDoc;
+    };
+    std::filesystem::remove(libraryFilename.asString());
+#endif
+}
@@ -34,6 +34,8 @@
 #endif
 
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <set>
@@ -343,6 +345,123 @@ TEST_CASE("GenShader: Track Dependencies", "[genshader]")
 #endif
 }
 
+TEST_CASE("GenShader: Source Cache", "[genshader]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr libraries = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, libraries);
+
+    mx::FilePath testFile = searchPath.find("resources/Materials/Examples/GltfPbr/gltf_pbr_boombox.mtlx");
+    mx::DocumentPtr testDoc = mx::createDocument();
+    mx::readFromXmlFile(testDoc, testFile);
+    testDoc->setDataLibrary(libraries);
+    mx::ElementPtr element = testDoc->getChild("Material_boombox");
+    REQUIRE(element);
+
+    // Missing files are not cached.
+    mx::SourceCachePtr cache = mx::SourceCache::create();
+    REQUIRE(!cache->getSourceFile(mx::FilePath("missing_source_file.glsl")));
+    REQUIRE(cache->size() == 0);
+
+    // Files rewritten within the same second are read again.
+    mx::FilePath sourcePath = mx::FilePath::getCurrentPath() / "source_cache_test.glsl";
+    for (std::string content : { "float a;\n", "float a;\nfloat b;\n" })
+    {
+        std::ofstream(sourcePath.asString()) << content;
+        mx::ConstSourceFilePtr sourceFile = cache->getSourceFile(sourcePath);
+        REQUIRE(sourceFile);
+        REQUIRE(sourceFile->getContent() == content);
+    }
+    REQUIRE(cache->getMissCount() == 3);
+    REQUIRE(cache->getSourceFile(sourcePath)->getLines().size() == 2);
+    REQUIRE(cache->getHitCount() == 1);
+    std::filesystem::remove(sourcePath.asString());
+    cache->clear();
+
+#ifdef MATERIALX_BUILD_GEN_GLSL
+    // Share a single source cache between two generation contexts.
+    mx::GenContext context1(mx::GlslShaderGenerator::create());
+    context1.registerSourceCodeSearchPath(searchPath);
+    context1.setSourceCache(cache);
+    mx::GenContext context2(mx::GlslShaderGenerator::create());
+    context2.registerSourceCodeSearchPath(searchPath);
+    context2.setSourceCache(cache);
+
+    mx::ShaderPtr shader1 = context1.getShaderGenerator().generate("shader", element, context1);
+    REQUIRE(cache->getMissCount() > 0);
+    REQUIRE(cache->size() == cache->getMissCount());
+
+    // The second generation reads no files from disk, and produces identical code.
+    size_t missCount = cache->getMissCount();
+    size_t hitCount = cache->getHitCount();
+    mx::ShaderPtr shader2 = context2.getShaderGenerator().generate("shader", element, context2);
+    REQUIRE(cache->getMissCount() == missCount);
+    REQUIRE(cache->getHitCount() > hitCount);
+    REQUIRE(shader1->getSourceCode(mx::Stage::PIXEL) == shader2->getSourceCode(mx::Stage::PIXEL));
+#endif
+}
+
+TEST_CASE("GenShader: Parallel Generation", "[genshader]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr libraries = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, libraries);
+
+    // Gather renderable elements from a set of example materials.
+    std::vector<mx::DocumentPtr> documents;
+    std::vector<mx::TypedElementPtr> elements;
+    mx::FilePath materialsPath = searchPath.find("resources/Materials/Examples/StandardSurface");
+    for (const mx::FilePath& filename : materialsPath.getFilesInDirectory(mx::MTLX_EXTENSION))
+    {
+        mx::DocumentPtr doc = mx::createDocument();
+        mx::readFromXmlFile(doc, materialsPath / filename, searchPath);
+        doc->setDataLibrary(libraries);
+        for (mx::TypedElementPtr elem : mx::findRenderableElements(doc))
+        {
+            elements.push_back(elem);
+        }
+        documents.push_back(doc);
+    }
+    REQUIRE(elements.size() > 1);
+
+#ifdef MATERIALX_BUILD_GEN_GLSL
+    mx::GenContext context(mx::GlslShaderGenerator::create());
+    context.registerSourceCodeSearchPath(searchPath);
+
+    // Parallel generation matches serial generation, in element order.
+    std::vector<mx::ShaderPtr> serialShaders = mx::generateShaders(elements, context, 1);
+    std::vector<mx::ShaderPtr> parallelShaders = mx::generateShaders(elements, context, 4);
+    REQUIRE(serialShaders.size() == elements.size());
+    REQUIRE(parallelShaders.size() == elements.size());
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+        REQUIRE(serialShaders[i]);
+        REQUIRE(parallelShaders[i]);
+        REQUIRE(serialShaders[i]->getName() == parallelShaders[i]->getName());
+        REQUIRE(serialShaders[i]->getSourceCode(mx::Stage::VERTEX) == parallelShaders[i]->getSourceCode(mx::Stage::VERTEX));
+        REQUIRE(serialShaders[i]->getSourceCode(mx::Stage::PIXEL) == parallelShaders[i]->getSourceCode(mx::Stage::PIXEL));
+    }
+
+    // Errors are reported to the caller.
+    mx::DocumentPtr invalidDoc = mx::createDocument();
+    mx::NodePtr invalidNode = invalidDoc->addNode("unknown_shader", "invalid", mx::SURFACE_SHADER_TYPE_STRING);
+    std::vector<mx::TypedElementPtr> invalidElements = elements;
+    invalidElements.push_back(invalidNode);
+    REQUIRE_THROWS(mx::generateShaders(invalidElements, context, 4));
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    // Measure generation throughput as the thread count increases.
+    for (unsigned int benchThreadCount : { 1, 2, 4, 8 })
+    {
+        BENCHMARK("Generate shaders with " + std::to_string(benchThreadCount) + " threads")
+        {
+            return mx::generateShaders(elements, context, benchThreadCount).size();
+        };
+    }
+#endif
+#endif
+}
+
 void variableTracker(mx::ShaderNode* node, mx::GenContext& /*context*/)
 {
     static mx::StringMap results;
@@ -452,3 +571,241 @@ TEST_CASE("GenShader: Track Application Variables", "[genshader]")
     }
 #endif
 }
+
+TEST_CASE("GenShader: Constant Folding", "[genshader]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr libraries = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, libraries);
+
+    // Create a graph of constant math nodes, along with a node that depends
+    // on a graph input and so cannot be folded.
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->setDataLibrary(libraries);
+    mx::NodeGraphPtr graph = doc->addNodeGraph("graph");
+    mx::InputPtr scale = graph->addInput("scale", "float");
+    scale->setValue(2.0f);
+    mx::NodePtr add = graph->addNode("add", "add", "color3");
+    add->setInputValue("in1", mx::Color3(0.25f, 0.5f, 0.75f));
+    add->setInputValue("in2", mx::Color3(0.25f));
+    mx::NodePtr mix = graph->addNode("mix", "mix", "color3");
+    mix->setConnectedNode("fg", add);
+    mix->setInputValue("bg", mx::Color3(0.0f));
+    mix->setInputValue("mix", 0.5f);
+    mx::NodePtr modulo = graph->addNode("modulo", "modulo", "float");
+    modulo->setInputValue("in1", -1.0f);
+    modulo->setInputValue("in2", 3.0f);
+    mx::NodePtr multiply = graph->addNode("multiply", "multiply", "float");
+    multiply->setConnectedNode("in1", modulo);
+    multiply->addInput("in2", "float")->setInterfaceName("scale");
+    graph->addOutput("out_mix", "color3")->setConnectedNode(mix);
+    graph->addOutput("out_modulo", "float")->setConnectedNode(modulo);
+    graph->addOutput("out_multiply", "float")->setConnectedNode(multiply);
+    REQUIRE(doc->validate());
+
+#ifdef MATERIALX_BUILD_GEN_GLSL
+    mx::GenContext context(mx::GlslShaderGenerator::create());
+    context.registerSourceCodeSearchPath(searchPath);
+    context.getOptions().shaderInterfaceType = mx::SHADER_INTERFACE_REDUCED;
+    mx::ShaderGenerator& generator = context.getShaderGenerator();
+
+    // Without folding, every math node is emitted.
+    mx::ShaderPtr shader = generator.generate("out_mix", graph->getOutput("out_mix"), context);
+    REQUIRE(shader->getGraph().getNodes().size() == 2);
+
+    // With folding, constant nodes are replaced by their values.
+    context.getOptions().foldConstantNodes = true;
+    shader = generator.generate("out_mix", graph->getOutput("out_mix"), context);
+    REQUIRE(shader->getGraph().getNodes().empty());
+    mx::ValuePtr value = shader->getGraph().getOutputSocket()->getValue();
+    REQUIRE(value);
+    REQUIRE(value->asA<mx::Color3>() == mx::Color3(0.25f, 0.375f, 0.5f));
+
+    shader = generator.generate("out_modulo", graph->getOutput("out_modulo"), context);
+    REQUIRE(shader->getGraph().getNodes().empty());
+    value = shader->getGraph().getOutputSocket()->getValue();
+    REQUIRE(value);
+    REQUIRE(value->asA<float>() == 2.0f);
+
+    // Nodes that depend on graph inputs are preserved.
+    shader = generator.generate("out_multiply", graph->getOutput("out_multiply"), context);
+    REQUIRE(shader->getGraph().getNodes().size() == 1);
+    REQUIRE(shader->getGraph().getNodes()[0]->getNodeString() == "multiply");
+
+    // Inputs published as uniforms are never folded.
+    context.getOptions().shaderInterfaceType = mx::SHADER_INTERFACE_COMPLETE;
+    shader = generator.generate("out_mix", graph->getOutput("out_mix"), context);
+    REQUIRE(shader->getGraph().getNodes().size() == 2);
+
+    // Folding never grows the shaders generated for the math test suite.
+    context.getOptions().shaderInterfaceType = mx::SHADER_INTERFACE_REDUCED;
+    size_t foldedSize = 0;
+    size_t unfoldedSize = 0;
+    mx::FilePath mathPath = searchPath.find("resources/Materials/TestSuite/stdlib/math");
+    for (const mx::FilePath& filename : mathPath.getFilesInDirectory(mx::MTLX_EXTENSION))
+    {
+        mx::DocumentPtr testDoc = mx::createDocument();
+        mx::readFromXmlFile(testDoc, mathPath / filename, searchPath);
+        testDoc->setDataLibrary(libraries);
+        for (mx::TypedElementPtr elem : mx::findRenderableElements(testDoc))
+        {
+            const std::string name = mx::createValidName(elem->getNamePath());
+            context.getOptions().foldConstantNodes = false;
+            mx::ShaderPtr unfolded = generator.generate(name, elem, context);
+            context.getOptions().foldConstantNodes = true;
+            mx::ShaderPtr folded = generator.generate(name, elem, context);
+            REQUIRE(folded->getGraph().getNodes().size() <= unfolded->getGraph().getNodes().size());
+            foldedSize += folded->getSourceCode(mx::Stage::PIXEL).size();
+            unfoldedSize += unfolded->getSourceCode(mx::Stage::PIXEL).size();
+        }
+    }
+    REQUIRE(foldedSize < unfoldedSize);
+#endif
+}
+
+TEST_CASE("GenShader: Duplicate Node Merging", "[genshader]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr libraries = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, libraries);
+
+    // Create a graph that samples the same image twice through duplicated
+    // texcoord and image chains, and an equivalent graph with one chain.
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->setDataLibrary(libraries);
+    auto addImageChain = [](mx::NodeGraphPtr graph, const std::string& suffix)
+    {
+        mx::NodePtr texcoord = graph->addNode("texcoord", "texcoord" + suffix, "vector2");
+        mx::NodePtr image = graph->addNode("image", "image" + suffix, "color3");
+        image->setInputValue("file", std::string("resources/Images/grid.png"), mx::FILENAME_TYPE_STRING);
+        image->setConnectedNode("texcoord", texcoord);
+        return image;
+    };
+    mx::NodeGraphPtr duplicated = doc->addNodeGraph("duplicated");
+    mx::NodePtr image1 = addImageChain(duplicated, "1");
+    mx::NodePtr image2 = addImageChain(duplicated, "2");
+    mx::NodePtr multiply = duplicated->addNode("multiply", "multiply", "color3");
+    multiply->setConnectedNode("in1", image1);
+    multiply->setConnectedNode("in2", image2);
+    duplicated->addOutput("out", "color3")->setConnectedNode(multiply);
+
+    mx::NodeGraphPtr single = doc->addNodeGraph("single");
+    image1 = addImageChain(single, "1");
+    multiply = single->addNode("multiply", "multiply", "color3");
+    multiply->setConnectedNode("in1", image1);
+    multiply->setConnectedNode("in2", image1);
+    single->addOutput("out", "color3")->setConnectedNode(multiply);
+    REQUIRE(doc->validate());
+
+#ifdef MATERIALX_BUILD_GEN_GLSL
+    mx::GenContext context(mx::GlslShaderGenerator::create());
+    context.registerSourceCodeSearchPath(searchPath);
+    context.getOptions().shaderInterfaceType = mx::SHADER_INTERFACE_REDUCED;
+    mx::ShaderGenerator& generator = context.getShaderGenerator();
+
+    auto countCalls = [](mx::ShaderPtr shader, const std::string& function)
+    {
+        const std::string& code = shader->getSourceCode(mx::Stage::PIXEL);
+        size_t count = 0;
+        for (size_t pos = code.find(function); pos != std::string::npos; pos = code.find(function, pos + 1))
+        {
+            count++;
+        }
+        return count;
+    };
+
+    // Without merging, each copy of the chain is emitted.
+    mx::ShaderPtr unmerged = generator.generate("shader", duplicated->getOutput("out"), context);
+    REQUIRE(unmerged->getGraph().getNodes().size() == 5);
+
+    // With merging, the duplicated graph produces the same code as the
+    // graph with a single chain, with fewer image lookups.
+    context.getOptions().mergeDuplicateNodes = true;
+    mx::ShaderPtr merged = generator.generate("shader", duplicated->getOutput("out"), context);
+    mx::ShaderPtr reference = generator.generate("shader", single->getOutput("out"), context);
+    REQUIRE(merged->getGraph().getNodes().size() == 3);
+    REQUIRE(merged->getSourceCode(mx::Stage::PIXEL) == reference->getSourceCode(mx::Stage::PIXEL));
+    REQUIRE(merged->getSourceCode(mx::Stage::VERTEX) == reference->getSourceCode(mx::Stage::VERTEX));
+    REQUIRE(countCalls(merged, "mx_image_color3(") < countCalls(unmerged, "mx_image_color3("));
+
+    // Nodes whose inputs are published as uniforms are never merged.
+    context.getOptions().shaderInterfaceType = mx::SHADER_INTERFACE_COMPLETE;
+    merged = generator.generate("shader", duplicated->getOutput("out"), context);
+    REQUIRE(merged->getGraph().getNodes().size() == 5);
+#endif
+}
+
+TEST_CASE("GenShader: Uniform Specialization", "[genshader]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr libraries = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, libraries);
+
+    // Create a graph whose math and conditional nodes depend on graph inputs.
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->setDataLibrary(libraries);
+    mx::NodeGraphPtr graph = doc->addNodeGraph("graph");
+    graph->addInput("scale", "float")->setValue(2.0f);
+    graph->addInput("threshold", "float")->setValue(0.5f);
+    mx::NodePtr multiply = graph->addNode("multiply", "multiply", "float");
+    multiply->addInput("in1", "float")->setInterfaceName("scale");
+    multiply->setInputValue("in2", 0.25f);
+    mx::NodePtr tint = graph->addNode("multiply", "tint", "color3");
+    tint->setInputValue("in1", mx::Color3(0.5f));
+    tint->addInput("in2", "float")->setInterfaceName("scale");
+    mx::NodePtr ifgreater = graph->addNode("ifgreater", "ifgreater", "color3");
+    ifgreater->addInput("value1", "float")->setInterfaceName("threshold");
+    ifgreater->setInputValue("value2", 0.25f);
+    ifgreater->setInputValue("in1", mx::Color3(1.0f, 0.0f, 0.0f));
+    ifgreater->setConnectedNode("in2", tint);
+    graph->addOutput("out_scaled", "float")->setConnectedNode(multiply);
+    graph->addOutput("out_branch", "color3")->setConnectedNode(ifgreater);
+    REQUIRE(doc->validate());
+
+#ifdef MATERIALX_BUILD_GEN_GLSL
+    mx::GenContext context(mx::GlslShaderGenerator::create());
+    context.registerSourceCodeSearchPath(searchPath);
+    context.getOptions().foldConstantNodes = true;
+    mx::ShaderGenerator& generator = context.getShaderGenerator();
+    auto getPublicUniform = [](mx::ShaderPtr shader, const std::string& name)
+    {
+        return shader->getStage(mx::Stage::PIXEL).getUniformBlock(mx::HW::PUBLIC_UNIFORMS).find(name);
+    };
+
+    // In the interactive mode, graph inputs and node inputs are published.
+    mx::ShaderPtr shader = generator.generate("shader", graph->getOutput("out_scaled"), context);
+    REQUIRE(shader->getGraph().getNodes().size() == 1);
+    REQUIRE(getPublicUniform(shader, "scale"));
+    REQUIRE(getPublicUniform(shader, "multiply_in2"));
+    REQUIRE(shader->getGraph().getSpecializedUniforms().empty());
+
+    // Specializing all uniforms bakes their values, allowing the graph to be folded.
+    context.getOptions().specializeUniforms = true;
+    shader = generator.generate("shader", graph->getOutput("out_scaled"), context);
+    REQUIRE(shader->getGraph().getNodes().empty());
+    REQUIRE(!getPublicUniform(shader, "scale"));
+    REQUIRE(!getPublicUniform(shader, "multiply_in2"));
+    REQUIRE(shader->getGraph().getOutputSocket()->getValue()->asA<float>() == 0.5f);
+    REQUIRE(shader->getGraph().getSpecializedUniforms() == mx::StringVec{ "graph/scale", "graph/multiply/in2" });
+
+    // Conditionals on specialized values keep only their selected branch.
+    shader = generator.generate("shader", graph->getOutput("out_branch"), context);
+    REQUIRE(shader->getGraph().getNodes().empty());
+    REQUIRE(shader->getGraph().getOutputSocket()->getValue()->asA<mx::Color3>() == mx::Color3(1.0f, 0.0f, 0.0f));
+
+    // Specializing selected uniforms leaves the others published.
+    context.getOptions().specializedUniforms = { "graph/scale" };
+    shader = generator.generate("shader", graph->getOutput("out_scaled"), context);
+    REQUIRE(shader->getGraph().getNodes().size() == 1);
+    REQUIRE(!getPublicUniform(shader, "scale"));
+    REQUIRE(getPublicUniform(shader, "multiply_in2"));
+    REQUIRE(shader->getGraph().getSpecializedUniforms() == mx::StringVec{ "graph/scale" });
+
+    // In the reduced interface, only graph inputs are specialized.
+    context.getOptions().shaderInterfaceType = mx::SHADER_INTERFACE_REDUCED;
+    context.getOptions().specializedUniforms.clear();
+    shader = generator.generate("shader", graph->getOutput("out_scaled"), context);
+    REQUIRE(shader->getGraph().getNodes().empty());
+    REQUIRE(shader->getGraph().getSpecializedUniforms() == mx::StringVec{ "graph/scale" });
+#endif
+}
@@ -6,6 +6,8 @@
 #include <MaterialXTest/External/Catch/catch.hpp>
 #include <MaterialXTest/MaterialXRender/RenderUtil.h>
 
+#include <MaterialXRender/CgltfLoader.h>
+#include <MaterialXRender/Harmonics.h>
 #include <MaterialXRender/ShaderRenderer.h>
 #include <MaterialXRender/StbImageLoader.h>
 #include <MaterialXRender/TinyObjLoader.h>
@@ -13,13 +15,23 @@
 
 #include <MaterialXFormat/Util.h>
 
+#ifdef MATERIALX_BUILD_GEN_GLSL
+#include <MaterialXGenGlsl/GlslShaderGenerator.h>
+#include <MaterialXGenHw/HwConstants.h>
+#endif
+
 #ifdef MATERIALX_BUILD_OIIO
 #include <MaterialXRender/OiioImageLoader.h>
 #endif
 
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <numeric>
+#include <set>
 #include <unordered_set>
 
 namespace mx = MaterialX;
@@ -148,6 +160,387 @@ TEST_CASE("Render: Geometry Handler Load", "[rendercore]")
     geomHandlerLog.close();
 }
 
+namespace
+{
+
+// Generate normals and tangents one face at a time, as a reference for
+// Mesh::generateNormals and Mesh::generateTangents.
+mx::FloatVec generateReferenceNormals(mx::MeshPtr mesh, mx::MeshStreamPtr positions)
+{
+    mx::FloatVec normals(positions->getData().size(), 0.0f);
+    mx::Vector3* n = reinterpret_cast<mx::Vector3*>(normals.data());
+    for (size_t i = 0; i < mesh->getPartitionCount(); i++)
+    {
+        const mx::MeshIndexBuffer& indices = mesh->getPartition(i)->getIndices();
+        for (size_t f = 0; f + 2 < indices.size(); f += 3)
+        {
+            const mx::Vector3& p0 = positions->getElement<mx::Vector3>(indices[f]);
+            const mx::Vector3& p1 = positions->getElement<mx::Vector3>(indices[f + 1]);
+            const mx::Vector3& p2 = positions->getElement<mx::Vector3>(indices[f + 2]);
+            mx::Vector3 faceNormal = (p1 - p0).cross(p2 - p0).getNormalized();
+            n[indices[f]] = n[indices[f + 1]] = n[indices[f + 2]] = faceNormal;
+        }
+    }
+    return normals;
+}
+
+mx::FloatVec generateReferenceTangentSums(mx::MeshPtr mesh, mx::MeshStreamPtr positions, mx::MeshStreamPtr texcoords)
+{
+    mx::FloatVec tangents(positions->getData().size(), 0.0f);
+    mx::Vector3* t = reinterpret_cast<mx::Vector3*>(tangents.data());
+    for (size_t i = 0; i < mesh->getPartitionCount(); i++)
+    {
+        const mx::MeshIndexBuffer& indices = mesh->getPartition(i)->getIndices();
+        for (size_t f = 0; f + 2 < indices.size(); f += 3)
+        {
+            const mx::Vector3& p0 = positions->getElement<mx::Vector3>(indices[f]);
+            const mx::Vector3& p1 = positions->getElement<mx::Vector3>(indices[f + 1]);
+            const mx::Vector3& p2 = positions->getElement<mx::Vector3>(indices[f + 2]);
+            const mx::Vector2& w0 = texcoords->getElement<mx::Vector2>(indices[f]);
+            const mx::Vector2& w1 = texcoords->getElement<mx::Vector2>(indices[f + 1]);
+            const mx::Vector2& w2 = texcoords->getElement<mx::Vector2>(indices[f + 2]);
+            float x1 = w1[0] - w0[0];
+            float x2 = w2[0] - w0[0];
+            float y1 = w1[1] - w0[1];
+            float y2 = w2[1] - w0[1];
+            float denom = x1 * y2 - x2 * y1;
+            float r = denom ? (1.0f / denom) : 0.0f;
+            mx::Vector3 faceTangent = ((p1 - p0) * y2 - (p2 - p0) * y1) * r;
+            t[indices[f]] += faceTangent;
+            t[indices[f + 1]] += faceTangent;
+            t[indices[f + 2]] += faceTangent;
+        }
+    }
+    return tangents;
+}
+
+bool floatsMatch(const mx::FloatVec& lhs, const mx::FloatVec& rhs)
+{
+    return lhs.size() == rhs.size() &&
+           std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(float)) == 0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Render: Mesh Attributes", "[rendercore]")
+{
+    mx::GeometryHandlerPtr handler = mx::GeometryHandler::create();
+    handler->addLoader(mx::TinyObjLoader::create());
+    handler->addLoader(mx::CgltfLoader::create());
+
+    mx::FilePath geomPath = mx::getDefaultDataSearchPath().find("resources/Geometry");
+    std::vector<mx::MeshPtr> meshes;
+    for (const char* extension : { "obj", "glb" })
+    {
+        for (const mx::FilePath& file : geomPath.getFilesInDirectory(extension))
+        {
+            REQUIRE(handler->loadGeometry(geomPath / file));
+        }
+    }
+    meshes = handler->getMeshes();
+    REQUIRE(!meshes.empty());
+
+    // Generated attributes match the serial reference, for all thread counts.
+    size_t maxFaceCount = 0;
+    for (mx::MeshPtr mesh : meshes)
+    {
+        mx::MeshStreamPtr positions = mesh->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0);
+        mx::MeshStreamPtr texcoords = mesh->getStream(mx::MeshStream::TEXCOORD_ATTRIBUTE, 0);
+        REQUIRE(positions);
+        size_t faceCount = 0;
+        for (size_t i = 0; i < mesh->getPartitionCount(); i++)
+        {
+            faceCount += mesh->getPartition(i)->getFaceCount();
+        }
+        maxFaceCount = std::max(maxFaceCount, faceCount);
+
+        mx::MeshStreamPtr normals = mesh->generateNormals(positions, 1);
+        REQUIRE(floatsMatch(normals->getData(), generateReferenceNormals(mesh, positions)));
+        for (unsigned int threadCount : { 0u, 2u, 5u })
+        {
+            REQUIRE(floatsMatch(mesh->generateNormals(positions, threadCount)->getData(), normals->getData()));
+        }
+        if (!texcoords)
+        {
+            continue;
+        }
+
+        mx::MeshStreamPtr tangents = mesh->generateTangents(positions, normals, texcoords, 1);
+        REQUIRE(tangents);
+        mx::MeshStreamPtr bitangents = mesh->generateBitangents(normals, tangents, 1);
+        REQUIRE(bitangents);
+        for (unsigned int threadCount : { 0u, 2u, 5u })
+        {
+            REQUIRE(floatsMatch(mesh->generateTangents(positions, normals, texcoords, threadCount)->getData(), tangents->getData()));
+            REQUIRE(floatsMatch(mesh->generateBitangents(normals, tangents, threadCount)->getData(), bitangents->getData()));
+        }
+
+        // Tangents are orthogonal to normals, and follow the accumulated face tangents.
+        mx::FloatVec tangentSums = generateReferenceTangentSums(mesh, positions, texcoords);
+        size_t mismatchCount = 0;
+        for (size_t v = 0; v < tangents->getSize(); v++)
+        {
+            const mx::Vector3& n = normals->getElement<mx::Vector3>(v);
+            const mx::Vector3& t = tangents->getElement<mx::Vector3>(v);
+            const mx::Vector3& sum = reinterpret_cast<const mx::Vector3*>(tangentSums.data())[v];
+            if (sum != mx::Vector3(0.0f) && t != (sum - n * n.dot(sum)).getNormalized())
+            {
+                mismatchCount++;
+            }
+        }
+        REQUIRE(mismatchCount == 0);
+    }
+    REQUIRE(maxFaceCount > 4 * 4096);
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    mx::MeshPtr largestMesh = meshes[0];
+    for (mx::MeshPtr mesh : meshes)
+    {
+        if (mesh->getVertexCount() > largestMesh->getVertexCount())
+        {
+            largestMesh = mesh;
+        }
+    }
+    mx::MeshStreamPtr positions = largestMesh->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0);
+    mx::MeshStreamPtr texcoords = largestMesh->getStream(mx::MeshStream::TEXCOORD_ATTRIBUTE, 0);
+    for (unsigned int threadCount : { 1u, 0u })
+    {
+        const std::string suffix = threadCount == 1 ? " (serial)" : " (parallel)";
+        BENCHMARK("Generate mesh normals" + suffix)
+        {
+            return largestMesh->generateNormals(positions, threadCount);
+        };
+        mx::MeshStreamPtr normals = largestMesh->generateNormals(positions, threadCount);
+        BENCHMARK("Generate mesh tangents" + suffix)
+        {
+            return largestMesh->generateTangents(positions, normals, texcoords, threadCount);
+        };
+    }
+#endif
+}
+
+TEST_CASE("Render: Vertex Welding", "[rendercore]")
+{
+    // Welded indices match a reference map from vertex components to indices,
+    // assigned in order of first appearance.
+    const size_t componentCount = 5;
+    mx::MeshVertexWelder welder(componentCount);
+    std::map<mx::FloatVec, uint32_t> reference;
+    for (size_t i = 0; i < 50000; i++)
+    {
+        mx::FloatVec vertex(componentCount);
+        for (size_t c = 0; c < componentCount; c++)
+        {
+            vertex[c] = (float) ((i * 7919 + c * 104729) % 23) - 11.0f;
+        }
+        if (i % 3 == 0)
+        {
+            vertex[0] = (i % 2) ? 0.0f : -0.0f;
+        }
+        bool added = false;
+        uint32_t index = welder.weld(vertex.data(), added);
+        auto it = reference.find(vertex);
+        if (it == reference.end())
+        {
+            REQUIRE(added);
+            REQUIRE(index == reference.size());
+            reference[vertex] = index;
+        }
+        else
+        {
+            REQUIRE(!added);
+            REQUIRE(index == it->second);
+        }
+        REQUIRE(std::equal(vertex.begin(), vertex.end(), welder.getVertex(index)));
+    }
+    REQUIRE(welder.getVertexCount() == reference.size());
+
+    // Welded and unwelded OBJ meshes describe the same faces, and welding an
+    // unwelded mesh preserves the components of every face vertex.
+    mx::FilePath geomPath = mx::getDefaultDataSearchPath().find("resources/Geometry");
+    mx::TinyObjLoaderPtr loader = mx::TinyObjLoader::create();
+    for (const mx::FilePath& file : geomPath.getFilesInDirectory("obj"))
+    {
+        mx::MeshList welded, unwelded;
+        REQUIRE(loader->load(geomPath / file, welded));
+        loader->setWeldVertices(false);
+        REQUIRE(loader->load(geomPath / file, unwelded));
+        loader->setWeldVertices(true);
+        REQUIRE((welded.size() == 1 && unwelded.size() == 1));
+
+        mx::MeshPtr mesh = unwelded[0];
+        mx::MeshStreamPtr weldedPositions = welded[0]->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0);
+        mx::MeshStreamPtr weldedTexcoords = welded[0]->getStream(mx::MeshStream::TEXCOORD_ATTRIBUTE, 0);
+        mx::MeshStreamPtr positions = mesh->getStream(mx::MeshStream::POSITION_ATTRIBUTE, 0);
+        mx::MeshStreamPtr texcoords = mesh->getStream(mx::MeshStream::TEXCOORD_ATTRIBUTE, 0);
+        REQUIRE(welded[0]->getVertexCount() <= mesh->getVertexCount());
+        REQUIRE(welded[0]->getMinimumBounds() == mesh->getMinimumBounds());
+        REQUIRE(welded[0]->getMaximumBounds() == mesh->getMaximumBounds());
+        REQUIRE(welded[0]->getPartitionCount() == mesh->getPartitionCount());
+
+        std::vector<mx::MeshIndexBuffer> originalIndices;
+        for (size_t p = 0; p < mesh->getPartitionCount(); p++)
+        {
+            const mx::MeshIndexBuffer& weldedIndices = welded[0]->getPartition(p)->getIndices();
+            const mx::MeshIndexBuffer& indices = mesh->getPartition(p)->getIndices();
+            REQUIRE(weldedIndices.size() == indices.size());
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                REQUIRE(weldedPositions->getElement<mx::Vector3>(weldedIndices[i]) == positions->getElement<mx::Vector3>(indices[i]));
+                REQUIRE(weldedTexcoords->getElement<mx::Vector2>(weldedIndices[i]) == texcoords->getElement<mx::Vector2>(indices[i]));
+            }
+            originalIndices.push_back(indices);
+        }
+
+        std::vector<mx::MeshStreamPtr> streams;
+        std::vector<mx::FloatVec> originalData;
+        for (const std::string& attribute : { mx::MeshStream::POSITION_ATTRIBUTE, mx::MeshStream::NORMAL_ATTRIBUTE,
+                                              mx::MeshStream::TEXCOORD_ATTRIBUTE, mx::MeshStream::TANGENT_ATTRIBUTE,
+                                              mx::MeshStream::BITANGENT_ATTRIBUTE })
+        {
+            mx::MeshStreamPtr stream = mesh->getStream(attribute, 0);
+            REQUIRE(stream);
+            streams.push_back(stream);
+            originalData.push_back(stream->getData());
+        }
+        size_t vertexCount = mesh->getVertexCount();
+        mesh->weldVertices();
+        REQUIRE(mesh->getVertexCount() <= vertexCount);
+        for (size_t s = 0; s < streams.size(); s++)
+        {
+            mx::MeshStreamPtr stream = streams[s];
+            const size_t stride = stream->getStride();
+            REQUIRE(stream->getSize() == mesh->getVertexCount());
+            for (size_t p = 0; p < mesh->getPartitionCount(); p++)
+            {
+                const mx::MeshIndexBuffer& indices = mesh->getPartition(p)->getIndices();
+                for (size_t i = 0; i < indices.size(); i++)
+                {
+                    REQUIRE(std::equal(originalData[s].begin() + originalIndices[p][i] * stride,
+                                       originalData[s].begin() + (originalIndices[p][i] + 1) * stride,
+                                       stream->getData().begin() + indices[i] * stride));
+                }
+            }
+        }
+    }
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    mx::FilePath teapotPath = geomPath / "teapot.obj";
+    for (bool weld : { true, false })
+    {
+        loader->setWeldVertices(weld);
+        BENCHMARK(weld ? "Load teapot.obj (welded)" : "Load teapot.obj (unwelded)")
+        {
+            mx::MeshList meshList;
+            loader->load(teapotPath, meshList);
+            return meshList;
+        };
+    }
+#endif
+}
+
+TEST_CASE("Render: Geometry Cache", "[rendercore]")
+{
+    mx::FilePath geomPath = mx::getDefaultDataSearchPath().find("resources/Geometry");
+    mx::FilePath cachePath = mx::FilePath::getCurrentPath() / "geometry_cache";
+    std::filesystem::remove_all(cachePath.asString());
+
+    auto createHandler = [&]()
+    {
+        mx::GeometryHandlerPtr handler = mx::GeometryHandler::create();
+        handler->addLoader(mx::TinyObjLoader::create());
+        handler->addLoader(mx::CgltfLoader::create());
+        handler->setGeometryCache(mx::GeometryCache::create(cachePath));
+        return handler;
+    };
+    const mx::FilePathVec files = { geomPath / "teapot.obj", geomPath / "shaderball.glb" };
+
+    // Geometry loaded from source is written to the cache.
+    mx::GeometryHandlerPtr sourceHandler = createHandler();
+    for (const mx::FilePath& file : files)
+    {
+        REQUIRE(sourceHandler->loadGeometry(file));
+        REQUIRE(sourceHandler->getGeometryCache()->getCachePath(file).exists());
+    }
+    REQUIRE(sourceHandler->getGeometryCache()->getHitCount() == 0);
+    REQUIRE(sourceHandler->getGeometryCache()->getMissCount() == files.size());
+
+    // Geometry restored from the cache matches geometry loaded from source.
+    mx::GeometryHandlerPtr cacheHandler = createHandler();
+    for (const mx::FilePath& file : files)
+    {
+        REQUIRE(cacheHandler->loadGeometry(file));
+    }
+    REQUIRE(cacheHandler->getGeometryCache()->getHitCount() == files.size());
+    REQUIRE(cacheHandler->getMeshes().size() == sourceHandler->getMeshes().size());
+    REQUIRE(cacheHandler->getMinimumBounds() == sourceHandler->getMinimumBounds());
+    REQUIRE(cacheHandler->getMaximumBounds() == sourceHandler->getMaximumBounds());
+    for (size_t m = 0; m < sourceHandler->getMeshes().size(); m++)
+    {
+        mx::MeshPtr sourceMesh = sourceHandler->getMeshes()[m];
+        mx::MeshPtr cacheMesh = cacheHandler->getMeshes()[m];
+        REQUIRE(cacheMesh->getName() == sourceMesh->getName());
+        REQUIRE(cacheMesh->getSourceUri() == sourceMesh->getSourceUri());
+        REQUIRE(cacheMesh->getVertexCount() == sourceMesh->getVertexCount());
+        REQUIRE(cacheMesh->getSphereCenter() == sourceMesh->getSphereCenter());
+        REQUIRE(cacheMesh->getSphereRadius() == sourceMesh->getSphereRadius());
+        REQUIRE(cacheMesh->getStreams().size() == sourceMesh->getStreams().size());
+        for (size_t s = 0; s < sourceMesh->getStreams().size(); s++)
+        {
+            mx::MeshStreamPtr sourceStream = sourceMesh->getStreams()[s];
+            mx::MeshStreamPtr cacheStream = cacheMesh->getStreams()[s];
+            REQUIRE(cacheStream->getName() == sourceStream->getName());
+            REQUIRE(cacheStream->getType() == sourceStream->getType());
+            REQUIRE(cacheStream->getIndex() == sourceStream->getIndex());
+            REQUIRE(cacheStream->getStride() == sourceStream->getStride());
+            REQUIRE(floatsMatch(cacheStream->getData(), sourceStream->getData()));
+        }
+        REQUIRE(cacheMesh->getPartitionCount() == sourceMesh->getPartitionCount());
+        for (size_t p = 0; p < sourceMesh->getPartitionCount(); p++)
+        {
+            REQUIRE(cacheMesh->getPartition(p)->getName() == sourceMesh->getPartition(p)->getName());
+            REQUIRE(cacheMesh->getPartition(p)->getFaceCount() == sourceMesh->getPartition(p)->getFaceCount());
+            REQUIRE(cacheMesh->getPartition(p)->getIndices() == sourceMesh->getPartition(p)->getIndices());
+        }
+    }
+
+    // Cache files are keyed on texture coordinate flipping.
+    mx::GeometryHandlerPtr flipHandler = createHandler();
+    REQUIRE(flipHandler->loadGeometry(files[0], true));
+    REQUIRE(flipHandler->getGeometryCache()->getMissCount() == 1);
+
+    // Invalid cache files are ignored and replaced.
+    mx::FilePath teapotCache = sourceHandler->getGeometryCache()->getCachePath(files[0]);
+    {
+        std::ofstream stream(teapotCache.asString(), std::ios::out | std::ios::binary | std::ios::trunc);
+        stream << "MTLXGEO";
+    }
+    mx::GeometryHandlerPtr invalidHandler = createHandler();
+    REQUIRE(invalidHandler->loadGeometry(files[0]));
+    REQUIRE(invalidHandler->getGeometryCache()->getMissCount() == 1);
+    REQUIRE(invalidHandler->getMeshes()[0]->getVertexCount() == sourceHandler->getMeshes()[0]->getVertexCount());
+    mx::MeshList meshes;
+    REQUIRE(invalidHandler->getGeometryCache()->read(files[0], meshes));
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    for (const mx::FilePath& file : files)
+    {
+        BENCHMARK("Load " + file.getBaseName() + " from source")
+        {
+            mx::GeometryHandlerPtr handler = createHandler();
+            handler->setGeometryCache(nullptr);
+            return handler->loadGeometry(file);
+        };
+        BENCHMARK("Load " + file.getBaseName() + " from cache")
+        {
+            return createHandler()->loadGeometry(file);
+        };
+    }
+#endif
+
+    std::filesystem::remove_all(cachePath.asString());
+}
+
 struct ImageHandlerTestOptions
 {
     mx::ImageHandlerPtr imageHandler;
@@ -243,3 +636,543 @@ TEST_CASE("Render: Image Handler Load", "[rendercore]")
     CHECK(imagesLoaded);
     imageHandlerLog.close();
 }
+
+namespace
+{
+
+// Reference implementations of image operations, built on per-texel access.
+
+mx::Color4 getReferenceAverageColor(mx::ImagePtr image)
+{
+    mx::Color4 averageColor;
+    for (unsigned int y = 0; y < image->getHeight(); y++)
+    {
+        for (unsigned int x = 0; x < image->getWidth(); x++)
+        {
+            averageColor += image->getTexelColor(x, y);
+        }
+    }
+    averageColor /= (float) (image->getWidth() * image->getHeight());
+    return averageColor;
+}
+
+mx::ImagePtr applyReferenceBoxBlur(mx::ImagePtr image)
+{
+    mx::ImagePtr blurImage = mx::Image::create(image->getWidth(), image->getHeight(), image->getChannelCount(), image->getBaseType());
+    blurImage->createResourceBuffer();
+    for (int y = 0; y < (int) image->getHeight(); y++)
+    {
+        for (int x = 0; x < (int) image->getWidth(); x++)
+        {
+            mx::Color4 blurColor;
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                int sy = std::min(std::max(y + dy, 0), (int) image->getHeight() - 1);
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    int sx = std::min(std::max(x + dx, 0), (int) image->getWidth() - 1);
+                    blurColor += image->getTexelColor(sx, sy);
+                }
+            }
+            blurColor /= 9.0f;
+            blurImage->setTexelColor(x, y, blurColor);
+        }
+    }
+    return blurImage;
+}
+
+mx::ImagePtr applyReferenceGaussianBlur(mx::ImagePtr image)
+{
+    mx::ImagePtr blurImage1 = mx::Image::create(image->getWidth(), image->getHeight(), image->getChannelCount(), image->getBaseType());
+    mx::ImagePtr blurImage2 = mx::Image::create(image->getWidth(), image->getHeight(), image->getChannelCount(), image->getBaseType());
+    blurImage1->createResourceBuffer();
+    blurImage2->createResourceBuffer();
+    for (int y = 0; y < (int) image->getHeight(); y++)
+    {
+        for (int x = 0; x < (int) image->getWidth(); x++)
+        {
+            mx::Color4 blurColor;
+            for (int dy = -3; dy <= 3; dy++)
+            {
+                int sy = std::min(std::max(y + dy, 0), (int) image->getHeight() - 1);
+                blurColor += image->getTexelColor(x, sy) * mx::GAUSSIAN_KERNEL_7[dy + 3];
+            }
+            blurImage1->setTexelColor(x, y, blurColor);
+        }
+    }
+    for (int y = 0; y < (int) image->getHeight(); y++)
+    {
+        for (int x = 0; x < (int) image->getWidth(); x++)
+        {
+            mx::Color4 blurColor;
+            for (int dx = -3; dx <= 3; dx++)
+            {
+                int sx = std::min(std::max(x + dx, 0), (int) image->getWidth() - 1);
+                blurColor += blurImage1->getTexelColor(sx, y) * mx::GAUSSIAN_KERNEL_7[dx + 3];
+            }
+            blurImage2->setTexelColor(x, y, blurColor);
+        }
+    }
+    return blurImage2;
+}
+
+mx::ImagePtr applyReferenceBoxDownsample(mx::ImagePtr image, unsigned int factor)
+{
+    mx::ImagePtr sampleImage = mx::Image::create(std::max(image->getWidth() / factor, 1u), std::max(image->getHeight() / factor, 1u),
+                                                 image->getChannelCount(), image->getBaseType());
+    sampleImage->createResourceBuffer();
+    for (int y = 0; y < (int) sampleImage->getHeight(); y++)
+    {
+        for (int x = 0; x < (int) sampleImage->getWidth(); x++)
+        {
+            mx::Color4 sampleColor;
+            for (int dy = 0; dy < (int) factor; dy++)
+            {
+                int sy = std::min(y * (int) factor + dy, (int) image->getHeight() - 1);
+                for (int dx = 0; dx < (int) factor; dx++)
+                {
+                    int sx = std::min(x * (int) factor + dx, (int) image->getWidth() - 1);
+                    sampleColor += image->getTexelColor(sx, sy);
+                }
+            }
+            sampleColor /= (float) (factor * factor);
+            sampleImage->setTexelColor(x, y, sampleColor);
+        }
+    }
+    return sampleImage;
+}
+
+bool imagesMatch(mx::ImagePtr image1, mx::ImagePtr image2)
+{
+    if (image1->getWidth() != image2->getWidth() || image1->getHeight() != image2->getHeight())
+    {
+        return false;
+    }
+    for (unsigned int y = 0; y < image1->getHeight(); y++)
+    {
+        for (unsigned int x = 0; x < image1->getWidth(); x++)
+        {
+            if (image1->getTexelColor(x, y) != image2->getTexelColor(x, y))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+mx::ImagePtr createGradientImage(unsigned int width, unsigned int height, unsigned int channelCount, mx::Image::BaseType baseType)
+{
+    mx::ImagePtr image = mx::Image::create(width, height, channelCount, baseType);
+    image->createResourceBuffer();
+    for (unsigned int y = 0; y < height; y++)
+    {
+        for (unsigned int x = 0; x < width; x++)
+        {
+            image->setTexelColor(x, y, mx::Color4((float) x / width, (float) y / height,
+                                                  (float) ((x * y) % 7) / 7.0f, 1.0f - (float) x / width));
+        }
+    }
+    return image;
+}
+
+// Project an environment to third-order SH one texel at a time, as a
+// reference for projectEnvironment.
+mx::Sh3ColorCoeffs projectReferenceEnvironment(mx::ConstImagePtr env)
+{
+    const double PI = std::acos(-1.0);
+    const double basis[5] = { std::sqrt(1.0 / (4.0 * PI)), std::sqrt(3.0 / (4.0 * PI)), std::sqrt(15.0 / (4.0 * PI)),
+                              std::sqrt(5.0 / (16.0 * PI)), std::sqrt(15.0 / (16.0 * PI)) };
+    mx::Sh3ColorCoeffs shEnv;
+    for (unsigned int y = 0; y < env->getHeight(); y++)
+    {
+        double theta = PI * (y + 0.5) / env->getHeight();
+        double texelWeight = (std::cos(y * PI / env->getHeight()) - std::cos((y + 1) * PI / env->getHeight())) *
+                             2.0 * PI / env->getWidth();
+        for (unsigned int x = 0; x < env->getWidth(); x++)
+        {
+            double phi = 2.0 * PI * (x + 0.5) / env->getWidth();
+            double dx = -std::sin(theta) * std::sin(phi);
+            double dy = -std::cos(theta);
+            double dz = std::sin(theta) * std::cos(phi);
+            const double shDir[9] = { basis[0], basis[1] * dy, basis[1] * dz, basis[1] * dx, basis[2] * dx * dy,
+                                      basis[2] * dy * dz, basis[3] * (3.0 * dz * dz - 1.0), basis[2] * dx * dz,
+                                      basis[4] * (dx * dx - dy * dy) };
+            mx::Color4 color = env->getTexelColor(x, y);
+            mx::Color3d weightedColor(color[0] * texelWeight, color[1] * texelWeight, color[2] * texelWeight);
+            for (size_t i = 0; i < shEnv.NUM_COEFFS; i++)
+            {
+                shEnv[i] += weightedColor * shDir[i];
+            }
+        }
+    }
+    return shEnv;
+}
+
+bool coeffsMatch(const mx::Sh3ColorCoeffs& lhs, const mx::Sh3ColorCoeffs& rhs, double tolerance)
+{
+    for (size_t i = 0; i < lhs.NUM_COEFFS; i++)
+    {
+        for (size_t c = 0; c < 3; c++)
+        {
+            if (std::abs(lhs[i][c] - rhs[i][c]) > tolerance)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Render: Image Cache", "[rendercore]")
+{
+    mx::FilePath imagePath = mx::getDefaultDataSearchPath().find("resources/Images");
+    mx::ImageHandlerPtr imageHandler = mx::ImageHandler::create(mx::StbImageLoader::create());
+    imageHandler->setSearchPath(mx::FileSearchPath(imagePath));
+
+    const mx::FilePathVec files = { "cloth.png", "grid.png", "brick_mask.jpg", "wood_color.jpg" };
+    std::vector<size_t> byteCounts;
+    for (const mx::FilePath& file : files)
+    {
+        mx::ImagePtr image = imageHandler->acquireImage(file);
+        REQUIRE(image);
+        byteCounts.push_back((size_t) image->getRowStride() * image->getHeight());
+    }
+    const mx::ImageCacheStats& stats = imageHandler->getImageCacheStats();
+    REQUIRE(stats.imageCount == files.size());
+    REQUIRE(stats.byteCount == std::accumulate(byteCounts.begin(), byteCounts.end(), (size_t) 0));
+    REQUIRE(stats.missCount == files.size());
+    REQUIRE(stats.hitCount == 0);
+
+    // Relative and absolute paths to the same file share a cache entry.
+    mx::ImagePtr relativeImage = imageHandler->acquireImage(files[0]);
+    mx::ImagePtr absoluteImage = imageHandler->acquireImage(imagePath / files[0]);
+    REQUIRE(relativeImage == absoluteImage);
+    REQUIRE(stats.hitCount == 2);
+    REQUIRE(stats.imageCount == files.size());
+    relativeImage = nullptr;
+    absoluteImage = nullptr;
+
+    // Least recently used images are evicted first.
+    imageHandler->acquireImage(files[0]);
+    imageHandler->setImageCacheBudget(byteCounts[0] + byteCounts[3]);
+    REQUIRE(stats.imageCount == 2);
+    REQUIRE(stats.evictionCount == 2);
+    REQUIRE(stats.byteCount <= imageHandler->getImageCacheBudget());
+    size_t hitCount = stats.hitCount;
+    imageHandler->acquireImage(files[0]);
+    imageHandler->acquireImage(files[3]);
+    REQUIRE(stats.hitCount == hitCount + 2);
+
+    // Images that are referenced outside of the cache are never evicted.
+    mx::ImagePtr heldImage = imageHandler->acquireImage(files[1]);
+    REQUIRE(stats.hitCount == hitCount + 2);
+    imageHandler->setImageCacheBudget(1);
+    REQUIRE(stats.imageCount == 1);
+    REQUIRE(imageHandler->acquireImage(files[1]) == heldImage);
+    REQUIRE(stats.byteCount == byteCounts[1]);
+
+    imageHandler->clearImageCache();
+    REQUIRE(stats.imageCount == 0);
+    REQUIRE(stats.byteCount == 0);
+}
+
+TEST_CASE("Render: Image Processing", "[rendercore]")
+{
+    // Texel conversions match the quantization of each base type.
+    mx::ImagePtr texelImage = mx::Image::create(1, 1, 4, mx::Image::BaseType::UINT8);
+    texelImage->createResourceBuffer();
+    texelImage->setTexelColor(0, 0, mx::Color4(0.0f, 0.5f, 1.0f, 0.25f));
+    const uint8_t* texelData = static_cast<const uint8_t*>(texelImage->getResourceBuffer());
+    REQUIRE((texelData[0] == 0 && texelData[1] == 128 && texelData[2] == 255 && texelData[3] == 64));
+    REQUIRE(texelImage->getTexelColor(0, 0) == mx::Color4(0.0f, 128 / 255.0f, 1.0f, 64 / 255.0f));
+    REQUIRE_THROWS(texelImage->getTexelColor(1, 0));
+
+    // Row-wise operations match their per-texel reference implementations
+    // for all base types and channel counts.
+    const std::vector<mx::Image::BaseType> baseTypes =
+    {
+        mx::Image::BaseType::UINT8,
+        mx::Image::BaseType::INT8,
+        mx::Image::BaseType::UINT16,
+        mx::Image::BaseType::INT16,
+        mx::Image::BaseType::HALF,
+        mx::Image::BaseType::FLOAT
+    };
+    for (mx::Image::BaseType baseType : baseTypes)
+    {
+        for (unsigned int channelCount = 1; channelCount <= 4; channelCount++)
+        {
+            mx::ImagePtr image = createGradientImage(37, 23, channelCount, baseType);
+            REQUIRE(image->getAverageColor() == getReferenceAverageColor(image));
+            REQUIRE(imagesMatch(image->applyBoxBlur(), applyReferenceBoxBlur(image)));
+            REQUIRE(imagesMatch(image->applyGaussianBlur(), applyReferenceGaussianBlur(image)));
+            REQUIRE(imagesMatch(image->applyBoxDownsample(4), applyReferenceBoxDownsample(image, 4)));
+            REQUIRE(imagesMatch(image->copy(4, mx::Image::BaseType::FLOAT), image));
+            REQUIRE(!image->isUniformColor());
+
+            mx::Color4 uniformColor;
+            mx::ImagePtr uniformImage = mx::createUniformImage(5, 3, channelCount, baseType, mx::Color4(0.5f));
+            REQUIRE(uniformImage->isUniformColor(&uniformColor));
+            REQUIRE(uniformColor == uniformImage->getTexelColor(4, 2));
+        }
+    }
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    // Compare per-texel and row-wise processing of 4k images.
+    for (mx::Image::BaseType baseType : { mx::Image::BaseType::FLOAT, mx::Image::BaseType::UINT8 })
+    {
+        const std::string typeName = (baseType == mx::Image::BaseType::FLOAT) ? "float" : "uint8";
+        mx::ImagePtr image = createGradientImage(4096, 4096, 4, baseType);
+        BENCHMARK("Per-texel average color, 4k " + typeName)
+        {
+            return getReferenceAverageColor(image);
+        };
+        BENCHMARK("Row-wise average color, 4k " + typeName)
+        {
+            return image->getAverageColor();
+        };
+        BENCHMARK("Per-texel box blur, 4k " + typeName)
+        {
+            return applyReferenceBoxBlur(image);
+        };
+        BENCHMARK("Row-wise box blur, 4k " + typeName)
+        {
+            return image->applyBoxBlur();
+        };
+        BENCHMARK("Per-texel Gaussian blur, 4k " + typeName)
+        {
+            return applyReferenceGaussianBlur(image);
+        };
+        BENCHMARK("Row-wise Gaussian blur, 4k " + typeName)
+        {
+            return image->applyGaussianBlur();
+        };
+    }
+#endif
+}
+
+TEST_CASE("Render: Environment Harmonics", "[rendercore]")
+{
+    mx::ImagePtr env = createGradientImage(64, 32, 4, mx::Image::BaseType::HALF);
+
+    // Projections match the per-texel reference, and are independent of the
+    // thread count.
+    mx::Sh3ColorCoeffs shEnv = mx::projectEnvironment(env, false, 1);
+    REQUIRE(coeffsMatch(shEnv, projectReferenceEnvironment(env), 1e-9));
+    REQUIRE(mx::projectEnvironment(env, false, 3) == shEnv);
+    REQUIRE(mx::projectEnvironment(env, false, 0) == shEnv);
+    mx::Sh3ColorCoeffs shIrradiance = mx::projectEnvironment(env, true, 3);
+    REQUIRE(coeffsMatch(shIrradiance, mx::projectEnvironment(env, true, 1), 0.0));
+    REQUIRE(std::abs(shIrradiance[1][0] - shEnv[1][0] * 2.0 / 3.0) < 1e-12);
+
+    // Derived operations are independent of the thread count.
+    mx::Vector3 lightDir1, lightDir2;
+    mx::Color3 lightColor1, lightColor2;
+    mx::computeDominantLight(env, lightDir1, lightColor1, 1);
+    mx::computeDominantLight(env, lightDir2, lightColor2, 4);
+    REQUIRE((lightDir1 == lightDir2 && lightColor1 == lightColor2));
+    REQUIRE(imagesMatch(mx::normalizeEnvironment(env, 1.0f, 0.5f, 1), mx::normalizeEnvironment(env, 1.0f, 0.5f, 4)));
+    REQUIRE(imagesMatch(mx::renderEnvironment(shEnv, 16, 8, 1), mx::renderEnvironment(shEnv, 16, 8, 4)));
+    REQUIRE(imagesMatch(mx::renderReferenceIrradiance(env, 4, 2, 1), mx::renderReferenceIrradiance(env, 4, 2, 2)));
+
+    // Empty environments have no dominant light.
+    mx::computeDominantLight(mx::createUniformImage(8, 4, 3, mx::Image::BaseType::FLOAT, mx::Color4(0.0f)),
+                             lightDir1, lightColor1);
+    REQUIRE(lightColor1 == mx::Color3(0.0f));
+
+#ifdef MATERIALX_BUILD_BENCHMARK_TESTS
+    mx::ImagePtr largeEnv = createGradientImage(4096, 2048, 3, mx::Image::BaseType::FLOAT);
+    BENCHMARK("Per-texel SH projection, 4k")
+    {
+        return projectReferenceEnvironment(largeEnv);
+    };
+    BENCHMARK("Serial SH projection, 4k")
+    {
+        return mx::projectEnvironment(largeEnv, false, 1);
+    };
+    BENCHMARK("Parallel SH projection, 4k")
+    {
+        return mx::projectEnvironment(largeEnv, false, 0);
+    };
+#endif
+}
+
+#ifdef MATERIALX_BUILD_GEN_GLSL
+TEST_CASE("Render: Shader Cache", "[rendercore]")
+{
+    mx::FileSearchPath searchPath = mx::getDefaultDataSearchPath();
+    mx::DocumentPtr libraries = mx::createDocument();
+    mx::loadLibraries({ "libraries" }, searchPath, libraries);
+
+    // Create materials of identical structure with differing input values.
+    auto createMaterial = [&libraries](float base, const mx::Color3& color, const std::string& suffix = "default")
+    {
+        mx::DocumentPtr doc = mx::createDocument();
+        doc->setDataLibrary(libraries);
+        mx::NodePtr shader = doc->addNode("standard_surface", "SR_" + suffix, mx::SURFACE_SHADER_TYPE_STRING);
+        shader->setInputValue("base", base);
+        shader->setInputValue("base_color", color);
+        doc->addMaterialNode("Material_" + suffix, shader);
+        return doc;
+    };
+    mx::DocumentPtr doc1 = createMaterial(0.8f, mx::Color3(0.1f, 0.2f, 0.3f));
+    mx::DocumentPtr doc2 = createMaterial(0.5f, mx::Color3(0.4f, 0.5f, 0.6f));
+    mx::NodePtr material1 = doc1->getNode("Material_default");
+    mx::NodePtr material2 = doc2->getNode("Material_default");
+
+    mx::GenContext context(mx::GlslShaderGenerator::create());
+    context.registerSourceCodeSearchPath(searchPath);
+    mx::ShaderCachePtr cache = mx::ShaderCache::create();
+    REQUIRE(mx::ShaderCache::getStructureHash(material1, context) ==
+            mx::ShaderCache::getStructureHash(material2, context));
+
+    mx::ShaderPtr shader1 = mx::createShader("Material_default", context, material1, cache);
+    REQUIRE(shader1);
+    REQUIRE(cache->getMissCount() == 1);
+    REQUIRE(cache->size() == 1);
+
+    // The second material is served from the cache, and matches a shader
+    // generated directly from the material.
+    mx::ShaderPtr shader2 = mx::createShader("Material_default", context, material2, cache);
+    mx::ShaderPtr expected2 = mx::createShader("Material_default", context, material2);
+    REQUIRE(shader2);
+    REQUIRE(cache->getHitCount() == 1);
+    REQUIRE(shader2 != shader1);
+    REQUIRE(shader2->getSourceCode(mx::Stage::VERTEX) == expected2->getSourceCode(mx::Stage::VERTEX));
+    REQUIRE(shader2->getSourceCode(mx::Stage::PIXEL) == expected2->getSourceCode(mx::Stage::PIXEL));
+    const mx::VariableBlock& uniforms2 = shader2->getStage(mx::Stage::PIXEL).getUniformBlock(mx::HW::PUBLIC_UNIFORMS);
+    const mx::VariableBlock& expectedUniforms2 = expected2->getStage(mx::Stage::PIXEL).getUniformBlock(mx::HW::PUBLIC_UNIFORMS);
+    REQUIRE(uniforms2.size() == expectedUniforms2.size());
+    for (size_t i = 0; i < uniforms2.size(); i++)
+    {
+        REQUIRE(uniforms2[i]->getPath() == expectedUniforms2[i]->getPath());
+        REQUIRE(uniforms2[i]->getValueString() == expectedUniforms2[i]->getValueString());
+    }
+
+    // The cached shader is unaffected by patching.
+    mx::VariableBlock& uniforms1 = shader1->getStage(mx::Stage::PIXEL).getUniformBlock(mx::HW::PUBLIC_UNIFORMS);
+    REQUIRE(uniforms1.find(mx::ShaderPortPredicate([](mx::ShaderPort* port)
+    {
+        return port->getPath() == "SR_default/base" && port->getValueString() == "0.8";
+    })));
+
+    // A material of identical structure with differing names is served from
+    // the cache, with uniform paths mapped onto its own elements.
+    mx::DocumentPtr doc4 = createMaterial(0.3f, mx::Color3(0.7f, 0.8f, 0.9f), "renamed");
+    mx::NodePtr material4 = doc4->getNode("Material_renamed");
+    REQUIRE(mx::ShaderCache::getStructureHash(material4, context) ==
+            mx::ShaderCache::getStructureHash(material1, context));
+    mx::ShaderPtr shader4 = mx::createShader("Material_renamed", context, material4, cache);
+    mx::ShaderPtr expected4 = mx::createShader("Material_renamed", context, material4);
+    REQUIRE(shader4);
+    REQUIRE(shader4->getName() == "Material_renamed");
+    REQUIRE(cache->getHitCount() == 2);
+    auto getUniformValues = [](mx::ShaderPtr shader)
+    {
+        std::map<std::string, std::string> values;
+        for (const mx::ShaderPort* port : shader->getStage(mx::Stage::PIXEL).getUniformBlock(mx::HW::PUBLIC_UNIFORMS).getVariableOrder())
+        {
+            values[port->getPath()] = port->getValueString();
+        }
+        return values;
+    };
+    REQUIRE(getUniformValues(shader4) == getUniformValues(expected4));
+    REQUIRE(getUniformValues(shader4).at("SR_renamed/base") == "0.3");
+
+    // A change in structure requires a new shader.
+    mx::DocumentPtr doc3 = createMaterial(0.5f, mx::Color3(0.4f, 0.5f, 0.6f));
+    doc3->getNode("SR_default")->setInputValue("metalness", 1.0f);
+    mx::NodePtr material3 = doc3->getNode("Material_default");
+    mx::createShader("Material_default", context, material3, cache);
+    REQUIRE(cache->getMissCount() == 2);
+    REQUIRE(cache->size() == 2);
+
+    // Materials whose texture filenames differ only in the file prefix or
+    // token values of their graphs resolve to distinct textures.
+    mx::DocumentPtr textureDoc = mx::createDocument();
+    textureDoc->setDataLibrary(libraries);
+    auto addTextureMaterial = [&textureDoc](const std::string& suffix, const std::string& filePrefix, const std::string& variant)
+    {
+        mx::NodeGraphPtr graph = textureDoc->addNodeGraph("NG_" + suffix);
+        graph->setFilePrefix(filePrefix);
+        graph->addToken("variant")->setValue(variant);
+        mx::NodePtr image = graph->addNode("image", "image", "color3");
+        image->setInputValue("file", std::string("wood_[variant].png"), mx::FILENAME_TYPE_STRING);
+        graph->addOutput("out", "color3")->setConnectedNode(image);
+        mx::NodePtr shader = textureDoc->addNode("standard_surface", "SR_" + suffix, mx::SURFACE_SHADER_TYPE_STRING);
+        shader->addInput("base_color", "color3")->setConnectedOutput(graph->getOutput("out"));
+        return textureDoc->addMaterialNode("Material_" + suffix, shader);
+    };
+    auto getFilenames = [](mx::ShaderPtr shader)
+    {
+        std::set<std::string> filenames;
+        for (const mx::ShaderPort* port : shader->getStage(mx::Stage::PIXEL).getUniformBlock(mx::HW::PUBLIC_UNIFORMS).getVariableOrder())
+        {
+            if (port->getType() == mx::Type::FILENAME)
+            {
+                filenames.insert(port->getValueString());
+            }
+        }
+        return filenames;
+    };
+    mx::NodePtr textureMaterialA = addTextureMaterial("A", "texA/", "oak");
+    mx::NodePtr textureMaterialB = addTextureMaterial("B", "texB/", "oak");
+    mx::NodePtr textureMaterialC = addTextureMaterial("C", "texA/", "pine");
+    cache->clear();
+    REQUIRE(getFilenames(mx::createShader("Material_A", context, textureMaterialA, cache)) ==
+            std::set<std::string>{ "texA/wood_oak.png" });
+    for (mx::NodePtr material : { textureMaterialB, textureMaterialC })
+    {
+        REQUIRE(mx::ShaderCache::getStructureHash(material, context) !=
+                mx::ShaderCache::getStructureHash(textureMaterialA, context));
+        mx::ShaderPtr shader = mx::createShader(material->getName(), context, material, cache);
+        mx::ShaderPtr expected = mx::createShader(material->getName(), context, material);
+        REQUIRE(getFilenames(shader) == getFilenames(expected));
+    }
+    REQUIRE(getFilenames(mx::createShader("Material_C", context, textureMaterialC)) ==
+            std::set<std::string>{ "texA/wood_pine.png" });
+    REQUIRE(cache->getHitCount() == 0);
+    REQUIRE(cache->getMissCount() == 3);
+
+    // Uniforms reported as specialized by shader generation select the same
+    // inputs when used as the cache's specialization options.
+    auto createGraph = [&libraries](const std::string& graphName, const std::string& inputName, const std::string& nodeName)
+    {
+        mx::DocumentPtr doc = mx::createDocument();
+        doc->setDataLibrary(libraries);
+        mx::NodeGraphPtr graph = doc->addNodeGraph(graphName);
+        graph->addInput(inputName, "float")->setValue(2.0f);
+        mx::NodePtr multiply = graph->addNode("multiply", nodeName, "float");
+        multiply->addInput("in1", "float")->setInterfaceName(inputName);
+        multiply->setInputValue("in2", 0.25f);
+        graph->addOutput("out", "float")->setConnectedNode(multiply);
+        return doc;
+    };
+    mx::DocumentPtr graphDoc = createGraph("graph", "scale", "multiply");
+    mx::InputPtr scale = graphDoc->getNodeGraph("graph")->getInput("scale");
+    mx::OutputPtr graphOutput = graphDoc->getNodeGraph("graph")->getOutput("out");
+
+    // Interface and node names are excluded from the structure of a graph.
+    mx::DocumentPtr renamedGraphDoc = createGraph("graph2", "gain", "node1");
+    REQUIRE(mx::ShaderCache::getStructureHash(graphOutput, context) ==
+            mx::ShaderCache::getStructureHash(renamedGraphDoc->getNodeGraph("graph2")->getOutput("out"), context));
+
+    context.getOptions().specializeUniforms = true;
+    context.getOptions().specializedUniforms = { "graph/scale" };
+    mx::ShaderPtr graphShader = context.getShaderGenerator().generate("shader", graphOutput, context);
+    REQUIRE(graphShader->getGraph().getSpecializedUniforms() == mx::StringVec{ "graph/scale" });
+
+    cache->clear();
+    for (float value : { 2.0f, 3.0f })
+    {
+        scale->setValue(value);
+        REQUIRE(cache->getShader("shader", graphOutput, context));
+        REQUIRE(cache->getShader("shader", graphOutput, context));
+    }
+    REQUIRE(cache->getMissCount() == 2);
+    REQUIRE(cache->getHitCount() == 2);
+}
+#endif
@@ -5,6 +5,7 @@
 
 #include <PyMaterialX/PyMaterialX.h>
 
+#include <MaterialXCore/Document.h>
 #include <MaterialXCore/Look.h>
 
 namespace py = pybind11;
@@ -81,6 +82,19 @@ void bindPyLook(py::module& mod)
         .def("getVisible", &mx::Visibility::getVisible)
         .def_readonly_static("CATEGORY", &mx::Visibility::CATEGORY);
 
+    py::class_<mx::LookAssignments>(mod, "LookAssignments")
+        .def_readonly("materialAssigns", &mx::LookAssignments::materialAssigns)
+        .def_readonly("propertyAssigns", &mx::LookAssignments::propertyAssigns)
+        .def_readonly("propertySetAssigns", &mx::LookAssignments::propertySetAssigns)
+        .def_readonly("visibilities", &mx::LookAssignments::visibilities);
+
+    py::class_<mx::LookIndex, mx::LookIndexPtr>(mod, "LookIndex")
+        .def_static("create", py::overload_cast<const std::vector<mx::LookPtr>&>(&mx::LookIndex::create))
+        .def_static("create", py::overload_cast<mx::ConstDocumentPtr>(&mx::LookIndex::create))
+        .def("getAssignments", py::overload_cast<const std::string&>(&mx::LookIndex::getAssignments, py::const_))
+        .def("getAssignments", py::overload_cast<const mx::StringVec&>(&mx::LookIndex::getAssignments, py::const_))
+        .def("getAssignmentCount", &mx::LookIndex::getAssignmentCount);
+
     mod.def("getGeometryBindings", &mx::getGeometryBindings,
         py::arg("materialNode") , py::arg("geom") = mx::UNIVERSAL_GEOM_NAME);
 }
@@ -0,0 +1,33 @@
+//
+// Copyright Contributors to the MaterialX Project
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXFormat/BinaryIo.h>
+#include <MaterialXCore/Document.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+void bindPyBinaryIo(py::module& mod)
+{
+    mod.def("readFromBinaryFile", &mx::readFromBinaryFile,
+        py::arg("doc"), py::arg("filename"), py::arg("searchPath") = mx::FileSearchPath());
+    mod.def("readFromBinaryString", [](mx::DocumentPtr doc, const py::bytes& data)
+        {
+            const std::string str = data;
+            mx::readFromBinaryBuffer(doc, str.data(), str.size());
+        },
+        py::arg("doc"), py::arg("data"));
+    mod.def("writeToBinaryFile", &mx::writeToBinaryFile,
+        py::arg("doc"), py::arg("filename"));
+    mod.def("writeToBinaryString", [](mx::DocumentPtr doc)
+        {
+            return py::bytes(mx::writeToBinaryString(doc));
+        },
+        py::arg("doc"));
+
+    mod.attr("MTLX_BINARY_EXTENSION") = mx::MTLX_BINARY_EXTENSION;
+}
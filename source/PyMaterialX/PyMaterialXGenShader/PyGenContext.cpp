@@ -22,11 +22,23 @@ void bindPyGenContext(py::module& mod)
         .def("registerSourceCodeSearchPath", static_cast<void (mx::GenContext::*)(const mx::FilePath&)>(&mx::GenContext::registerSourceCodeSearchPath))
         .def("registerSourceCodeSearchPath", static_cast<void (mx::GenContext::*)(const mx::FileSearchPath&)>(&mx::GenContext::registerSourceCodeSearchPath))
         .def("resolveSourceFile", &mx::GenContext::resolveSourceFile)
+        .def("setSourceCache", &mx::GenContext::setSourceCache)
+        .def("getSourceCache", &mx::GenContext::getSourceCache)
         .def("pushUserData", &mx::GenContext::pushUserData)
         .def("setApplicationVariableHandler", &mx::GenContext::setApplicationVariableHandler)
         .def("getApplicationVariableHandler", &mx::GenContext::getApplicationVariableHandler);
 }
 
+void bindPySourceCache(py::module& mod)
+{
+    py::class_<mx::SourceCache, mx::SourceCachePtr>(mod, "SourceCache")
+        .def_static("create", &mx::SourceCache::create)
+        .def("clear", &mx::SourceCache::clear)
+        .def("size", &mx::SourceCache::size)
+        .def("getHitCount", &mx::SourceCache::getHitCount)
+        .def("getMissCount", &mx::SourceCache::getMissCount);
+}
+
 void bindPyGenUserData(py::module& mod)
 {
     py::class_<mx::GenUserData, mx::GenUserDataPtr>(mod, "GenUserData")
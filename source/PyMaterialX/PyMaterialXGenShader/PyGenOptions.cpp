@@ -31,6 +31,10 @@ void bindPyGenOptions(py::module& mod)
         .def_readwrite("addUpstreamDependencies", &mx::GenOptions::addUpstreamDependencies)
         .def_readwrite("libraryPrefix", &mx::GenOptions::libraryPrefix)        
         .def_readwrite("emitColorTransforms", &mx::GenOptions::emitColorTransforms)
+        .def_readwrite("foldConstantNodes", &mx::GenOptions::foldConstantNodes)
+        .def_readwrite("mergeDuplicateNodes", &mx::GenOptions::mergeDuplicateNodes)
+        .def_readwrite("specializeUniforms", &mx::GenOptions::specializeUniforms)
+        .def_readwrite("specializedUniforms", &mx::GenOptions::specializedUniforms)
         .def_readwrite("hwTransparency", &mx::GenOptions::hwTransparency)
         .def_readwrite("hwSpecularEnvironmentMethod", &mx::GenOptions::hwSpecularEnvironmentMethod)
         .def_readwrite("hwSrgbEncodeOutput", &mx::GenOptions::hwSrgbEncodeOutput)
@@ -11,6 +11,7 @@ void bindPyColorManagement(py::module& mod);
 void bindPyShaderPort(py::module& mod);
 void bindPyShader(py::module& mod);
 void bindPyShaderGenerator(py::module& mod);
+void bindPySourceCache(py::module& mod);
 void bindPyGenContext(py::module& mod);
 void bindPyHwShaderGenerator(py::module& mod);
 void bindPyHwResourceBindingContext(py::module &mod);
@@ -30,6 +31,7 @@ PYBIND11_MODULE(PyMaterialXGenShader, mod)
     bindPyShaderPort(mod);
     bindPyShader(mod);
     bindPyShaderGenerator(mod);
+    bindPySourceCache(mod);
     bindPyGenContext(mod);
     bindPyHwShaderGenerator(mod);
     bindPyGenOptions(mod);
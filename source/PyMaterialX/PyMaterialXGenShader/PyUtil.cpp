@@ -6,6 +6,8 @@
 #include <PyMaterialX/PyMaterialX.h>
 
 #include <MaterialXGenShader/Util.h>
+#include <MaterialXGenShader/GenContext.h>
+#include <MaterialXGenShader/Shader.h>
 #include <MaterialXGenShader/ShaderGenerator.h>
 
 namespace py = pybind11;
@@ -30,6 +32,9 @@ void bindPyUtil(py::module& mod)
     mod.def("elementRequiresShading", &mx::elementRequiresShading);
     mod.def("findRenderableMaterialNodes", &findRenderableMaterialNodes);
     mod.def("findRenderableElements", &findRenderableElements, py::arg("doc"), py::arg("includeReferencedGraphs") = false);
+    mod.def("generateShaders", &mx::generateShaders,
+        py::arg("elements"), py::arg("context"), py::arg("threadCount") = 1,
+        py::call_guard<py::gil_scoped_release>());
     mod.def("getNodeDefInput", &mx::getNodeDefInput);
     mod.def("tokenSubstitution", &mx::tokenSubstitution);
     mod.def("getUdimCoordinates", &mx::getUdimCoordinates);
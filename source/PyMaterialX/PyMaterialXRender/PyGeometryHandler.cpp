@@ -38,6 +38,19 @@ void bindPyGeometryHandler(py::module& mod)
         .def("supportedExtensions", &mx::GeometryLoader::supportedExtensions)
         .def("load", &mx::GeometryLoader::load);
 
+    py::class_<mx::GeometryCache, mx::GeometryCachePtr>(mod, "GeometryCache")
+        .def(py::init<const mx::FilePath&>())
+        .def_static("create", &mx::GeometryCache::create)
+        .def("getDirectory", &mx::GeometryCache::getDirectory)
+        .def("getCachePath", &mx::GeometryCache::getCachePath,
+            py::arg("sourcePath"), py::arg("texcoordVerticalFlip") = false)
+        .def("read", &mx::GeometryCache::read,
+            py::arg("sourcePath"), py::arg("meshList"), py::arg("texcoordVerticalFlip") = false)
+        .def("write", &mx::GeometryCache::write,
+            py::arg("sourcePath"), py::arg("meshList"), py::arg("texcoordVerticalFlip") = false)
+        .def("getHitCount", &mx::GeometryCache::getHitCount)
+        .def("getMissCount", &mx::GeometryCache::getMissCount);
+
     py::class_<mx::GeometryHandler, mx::GeometryHandlerPtr>(mod, "GeometryHandler")
         .def(py::init<>())
         .def_static("create", &mx::GeometryHandler::create)
@@ -46,6 +59,8 @@ void bindPyGeometryHandler(py::module& mod)
         .def("hasGeometry", &mx::GeometryHandler::hasGeometry)
         .def("getGeometry", &mx::GeometryHandler::getGeometry)
         .def("loadGeometry", &mx::GeometryHandler::loadGeometry)
+        .def("setGeometryCache", &mx::GeometryHandler::setGeometryCache)
+        .def("getGeometryCache", &mx::GeometryHandler::getGeometryCache)
         .def("getMeshes", &mx::GeometryHandler::getMeshes)
         .def("findParentMesh", &mx::GeometryHandler::findParentMesh)
         .def("getMinimumBounds", &mx::GeometryHandler::getMinimumBounds)
@@ -68,6 +68,13 @@ void bindPyImageHandler(py::module& mod)
         .def("saveImage", &mx::ImageLoader::saveImage)
         .def("loadImage", &mx::ImageLoader::loadImage);
 
+    py::class_<mx::ImageCacheStats>(mod, "ImageCacheStats")
+        .def_readonly("imageCount", &mx::ImageCacheStats::imageCount)
+        .def_readonly("byteCount", &mx::ImageCacheStats::byteCount)
+        .def_readonly("hitCount", &mx::ImageCacheStats::hitCount)
+        .def_readonly("missCount", &mx::ImageCacheStats::missCount)
+        .def_readonly("evictionCount", &mx::ImageCacheStats::evictionCount);
+
     py::class_<mx::ImageHandler, mx::ImageHandlerPtr>(mod, "ImageHandler")
         .def_static("create", &mx::ImageHandler::create)
         .def("addLoader", &mx::ImageHandler::addLoader)
@@ -86,6 +93,9 @@ void bindPyImageHandler(py::module& mod)
         .def("releaseRenderResources", &mx::ImageHandler::releaseRenderResources,
             py::arg("image") = nullptr)
         .def("clearImageCache", &mx::ImageHandler::clearImageCache)
+        .def("setImageCacheBudget", &mx::ImageHandler::setImageCacheBudget)
+        .def("getImageCacheBudget", &mx::ImageHandler::getImageCacheBudget)
+        .def("getImageCacheStats", &mx::ImageHandler::getImageCacheStats, py::return_value_policy::reference_internal)
         .def("getZeroImage", &mx::ImageHandler::getZeroImage)
         .def("getReferencedImages", &mx::ImageHandler::getReferencedImages);
 }
@@ -54,6 +54,7 @@ void bindPyMesh(py::module& mod)
         .def("getSourceUri", &mx::Mesh::getSourceUri)
         .def("getStream", static_cast<mx::MeshStreamPtr (mx::Mesh::*)(const std::string&) const>(&mx::Mesh::getStream))
         .def("getStream", static_cast<mx::MeshStreamPtr (mx::Mesh::*)(const std::string&, unsigned int) const> (&mx::Mesh::getStream))
+        .def("getStreams", &mx::Mesh::getStreams)
         .def("addStream", &mx::Mesh::addStream)
         .def("setVertexCount", &mx::Mesh::setVertexCount)
         .def("getVertexCount", &mx::Mesh::getVertexCount)
@@ -73,5 +74,6 @@ void bindPyMesh(py::module& mod)
         .def("generateTangents", &mx::Mesh::generateTangents)
         .def("generateBitangents", &mx::Mesh::generateBitangents)
         .def("mergePartitions", &mx::Mesh::mergePartitions)
+        .def("weldVertices", &mx::Mesh::weldVertices)
         .def("splitByUdims", &mx::Mesh::splitByUdims);
 }
@@ -15,5 +15,7 @@ void bindPyTinyObjLoader(py::module& mod)
     py::class_<mx::TinyObjLoader, mx::TinyObjLoaderPtr, mx::GeometryLoader>(mod, "TinyObjLoader")
         .def_static("create", &mx::TinyObjLoader::create)
         .def(py::init<>())
-        .def("load", &mx::TinyObjLoader::load);
+        .def("load", &mx::TinyObjLoader::load)
+        .def("setWeldVertices", &mx::TinyObjLoader::setWeldVertices)
+        .def("getWeldVertices", &mx::TinyObjLoader::getWeldVertices);
 }